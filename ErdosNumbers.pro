@@ -5,21 +5,22 @@
 #-------------------------------------------------
 
 QT       += core gui
-QT       += xml
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 TARGET = ErdosNumbers
 TEMPLATE = app
-CONFIG += c++11
-QMAKE_CXXFLAGS_RELEASE += -O2
+
+include(erdoscore.pri)
 
 
 SOURCES += main.cpp\
         erdoswindow.cpp \
-    authorsgraph.cpp
+        job.cpp \
+        ranktablemodel.cpp
 
 HEADERS  += erdoswindow.h \
-    authorsgraph.h
+        job.h \
+        ranktablemodel.h
 
 FORMS    += erdoswindow.ui
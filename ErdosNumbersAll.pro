@@ -0,0 +1,16 @@
+#-------------------------------------------------
+#
+# Buduje aplikacje okienkowa, konsolowa i pomiarowa
+#
+#-------------------------------------------------
+
+TEMPLATE = subdirs
+
+gui.file = ErdosNumbers.pro
+gui.makefile = Makefile.gui
+cli.file = ErdosNumbersCli.pro
+cli.makefile = Makefile.cli
+bench.file = ErdosNumbersBench.pro
+bench.makefile = Makefile.bench
+
+SUBDIRS = gui cli bench
@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# Program pomiarowy - serie pomiarow ladowania i algorytmow (CSV/JSON)
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = erdos-bench
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(erdoscore.pri)
+
+# osobne pliki obiektowe - projekt dzieli katalog z aplikacja okienkowa
+OBJECTS_DIR = bench-obj
+MOC_DIR = bench-obj
+
+
+SOURCES += benchmain.cpp
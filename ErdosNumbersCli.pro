@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# Konsolowa wersja programu - bez QtWidgets, do zadan wsadowych
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = erdos-cli
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(erdoscore.pri)
+
+# osobne pliki obiektowe - projekt dzieli katalog z aplikacja okienkowa
+OBJECTS_DIR = cli-obj
+MOC_DIR = cli-obj
+
+
+SOURCES += climain.cpp
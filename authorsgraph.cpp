@@ -8,190 +8,1855 @@
 
 
 #include "authorsgraph.h"
+#include "bitmap.h"
+#include "bitops.h"
+#include "priorityqueues.h"
+#include "mappedfile.h"
+#include "parallel.h"
 #include <queue>
+#include <set>
 #include <limits>
+#include <algorithm>
+#include <iterator>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <cstring>
+#include <utility>
 
 
 using namespace std;
 
 
+const int AuthorsGraph::INFINITE_RANK = numeric_limits<int>::max();
+const int AuthorsGraph::DO_ALPHA = 14;
+const int AuthorsGraph::DO_BETA = 24;
+const size_t AuthorsGraph::PARALLEL_CHUNK = 256;
+const size_t AuthorsGraph::MULTI_SOURCE_WIDTH = 256;
+const size_t AuthorsGraph::PROGRESS_INTERVAL = 65536;
+const uint32_t AuthorsGraph::SNAPSHOT_VERSION = 3;
+
+
+namespace
+{
+/**
+ * \brief Bariera synchronizujaca staly zbior watkow (wielokrotnego uzytku)
+ */
+class Barrier
+{
+    mutex lock;
+    condition_variable released;
+    int count; // liczba watkow
+    int waiting; // liczba watkow czekajacych w biezacej rundzie
+    unsigned generation; // numer rundy
+
+public:
+    explicit Barrier(int n) : count(n), waiting(0), generation(0)
+    {}
+
+    void wait()
+    {
+        unique_lock<mutex> guard(lock);
+        unsigned gen = generation;
+
+        if(++waiting == count) // ostatni watek zwalnia pozostale
+        {
+            waiting = 0;
+            ++generation;
+            released.notify_all();
+        }
+        else
+            released.wait(guard, [&]{ return gen != generation; });
+    }
+};
+
+/**
+ * \brief Pobiera pierwsza paczke zakresu (wlasciciel zakresu)
+ * \param chunks Zakres paczek (pierwsza << 32 | koniec)
+ * \param chunk Zmienna, do ktorej zostanie zapisany numer paczki
+ * \return Zwraca false, jesli zakres jest pusty
+ */
+bool takeFirstChunk(atomic<uint64_t> &chunks, uint64_t &chunk)
+{
+    uint64_t range = chunks.load(memory_order_relaxed);
+
+    while((range >> 32) < (range & 0xffffffffu))
+        if(chunks.compare_exchange_weak(range, range + (uint64_t(1) << 32), memory_order_relaxed))
+        {
+            chunk = range >> 32;
+            return true;
+        }
+
+    return false;
+}
+
+/**
+ * \brief Kradnie ostatnia paczke zakresu innego watku. Zakres jedynie sie zmniejsza, wiec porownanie z wymiana
+ * nie jest narazone na problem ABA
+ * \param chunks Zakres paczek (pierwsza << 32 | koniec)
+ * \param chunk Zmienna, do ktorej zostanie zapisany numer paczki
+ * \return Zwraca false, jesli zakres jest pusty
+ */
+bool takeLastChunk(atomic<uint64_t> &chunks, uint64_t &chunk)
+{
+    uint64_t range = chunks.load(memory_order_relaxed);
+
+    while((range >> 32) < (range & 0xffffffffu))
+        if(chunks.compare_exchange_weak(range, range - 1, memory_order_relaxed))
+        {
+            chunk = (range & 0xffffffffu) - 1;
+            return true;
+        }
+
+    return false;
+}
+
+const char SNAPSHOT_MAGIC[8] = {'E','R','D','O','S','C','S','R'}; // sygnatura pliku migawki
+const uint32_t SNAPSHOT_ENDIANNESS = 0x01020304; // znacznik kolejnosci bajtow
+
+/**
+ * \brief Naglowek pliku migawki. Polozenia sekcji liczone sa w bajtach od poczatku pliku
+ */
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t endianness;
+    uint64_t nodeCount;
+    uint64_t edgeEntries;
+    uint64_t nameBytes;
+    uint64_t offsetsPos; // uint32_t[nodeCount+1]
+    uint64_t neighborsPos; // uint32_t[edgeEntries]
+    uint64_t nameOffsetsPos; // uint32_t[nodeCount+1]
+    uint64_t nameOrderPos; // uint32_t[nodeCount]
+    uint64_t componentsPos; // uint32_t[nodeCount] - numer skladowej autora
+    uint64_t componentSizesPos; // uint32_t[componentSlots] - rozmiary skladowych (0 - numer pusty)
+    uint64_t originalIdsPos; // uint32_t[originalIdsCount] - pierwotne identyfikatory przenumerowanych autorow
+    uint64_t nameCharsPos; // char[nameBytes]
+    uint64_t componentSlots; // liczba numerow skladowych
+    uint64_t componentsCount; // liczba skladowych
+    uint64_t largestComponent; // rozmiar najwiekszej skladowej
+    uint64_t isolatedAuthors; // liczba autorow bez wspolpracownikow
+    uint64_t originalIdsCount; // liczba autorow przenumerowanych przy zamrozeniu (0 - kolejnosc naturalna)
+    uint64_t fileSize;
+};
+
+uint64_t align8(uint64_t pos)
+{
+    return (pos + 7) & ~uint64_t(7);
+}
+
+/**
+ * \brief Sprawdza czy sekcja miesci sie w pliku
+ */
+bool sectionFits(uint64_t pos, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+{
+    return pos % 4 == 0 && pos <= fileSize && count <= (fileSize - pos) / elementSize;
+}
+}
+
+
+const char* vertexOrderName(VertexOrder order)
+{
+    switch(order)
+    {
+    case DEGREE_ORDER:
+        return "degree";
+    case BFS_ORDER:
+        return "bfs";
+    case RCM_ORDER:
+        return "rcm";
+    default:
+        return "natural";
+    }
+}
+
+bool findVertexOrder(const string &name, VertexOrder &order)
+{
+    for(VertexOrder o: {NATURAL_ORDER, DEGREE_ORDER, BFS_ORDER, RCM_ORDER})
+        if(name == vertexOrderName(o))
+        {
+            order = o;
+            return true;
+        }
+
+    return false;
+}
+
+
+AuthorsGraph::AuthorsGraph() : nodeCount(0), rootName("Erdos"), vertexOrder(NATURAL_ORDER), compressAdjacency(false), frozen(false),
+    coAuthorLists(false), bipartite(false), progress(nullptr), buildThreads(1)
+{
+    clear();
+}
+
+AuthorsGraph::~AuthorsGraph()
+{}
+
+
+AuthorsGraph::AuthorId AuthorsGraph::addAuthor(string_view name)
+{
+    AuthorId id = names.intern(name);
+
+    if(id == (AuthorId)nodeCount) // nowy autor - arena nadala kolejny identyfikator
+    {
+        if(!hasPapers())
+            coWritersLists.emplace_back();
+        components.addAuthor();
+        ++nodeCount;
+    }
+
+    return id;
+}
+
+void AuthorsGraph::addPublication(const vector<AuthorId> &coAuthors)
+{
+    for(size_t i = 1; i < coAuthors.size(); ++i) // autorzy publikacji naleza do jednej skladowej
+        components.unite(coAuthors[0], coAuthors[i]);
+
+    if(hasPapers()) // hiperkrawedz - autorzy publikacji dopisywani raz, bez rozwijania w pary
+    {
+        size_t begin = paperMembers.size();
+
+        paperMembers.insert(paperMembers.end(), coAuthors.begin(), coAuthors.end());
+        sort(paperMembers.begin() + begin, paperMembers.end());
+        paperMembers.erase(unique(paperMembers.begin() + begin, paperMembers.end()), paperMembers.end());
+
+        paperOffsets.push_back(paperMembers.size()); // numer publikacji to jej kolejnosc ladowania
+
+        return;
+    }
+
+    for(auto j = coAuthors.begin(); j != coAuthors.end(); ++j) // dodawanie krawedzi, duplikaty usuwa freeze()
+        for(auto k = j+1; k != coAuthors.end(); ++k)
+        {
+            if(*j == *k)
+                continue;
+
+            coWritersLists[*j].push_back(*k);
+            coWritersLists[*k].push_back(*j);
+        }
+}
+
+void AuthorsGraph::addPublication(const vector<string> &coAuthors, bool createAuthors)
+{
+    vector<AuthorId> ids; //Wektor wspolautorow
+    AuthorId id;
+
+    for(auto& name: coAuthors)
+    {
+        if(createAuthors) //ladowanie wezlow bez powtorzen w oparciu o dana publikacje
+            ids.push_back(addAuthor(name));
+        else if(names.find(name, id)) // autorzy spoza listy nie sa wezlami grafu
+            ids.push_back(id);
+    }
+
+    addPublication(ids);
+}
 
 void AuthorsGraph::loadGraph(vector<string> &authors, vector<vector<string>>& publications)
 {
+    uint64_t edges = 0; // krawedzie dodane od poprzedniego punktu kontrolnego
+
+    clear();
+
+    for(auto& i :authors) //Ladowanie wezlow na podstawie listy autorow
+        addAuthor(i);
+
+    if(buildThreads > 1 && !bipartite)
+    {
+        loadGraphParallel(publications, false);
+        return;
+    }
+
+    for(size_t i = 0; i < publications.size(); ++i) // ladowanie krawedzi grafow na podstawie publikacji
+    {
+        addPublication(publications[i], false);
+        edges += publicationEdges(publications[i].size());
+
+        if((i + 1) % PROGRESS_INTERVAL == 0 && !reportProgress(0, exchange(edges, 0)))
+        {
+            clear();
+            return;
+        }
+    }
+
+    reportProgress(0, edges);
+    freeze();
+}
+
+void AuthorsGraph::loadGraph(vector<vector<string> > &publications)
+{
+    uint64_t edges = 0;
+
+    clear();
+
+    if(buildThreads > 1 && !bipartite)
+    {
+        loadGraphParallel(publications, true);
+        return;
+    }
+
+    for(size_t i = 0; i < publications.size(); ++i)
+    {
+        addPublication(publications[i], true);
+        edges += publicationEdges(publications[i].size());
+
+        if((i + 1) % PROGRESS_INTERVAL == 0 && !reportProgress(0, exchange(edges, 0)))
+        {
+            clear();
+            return;
+        }
+    }
+
+    reportProgress(0, edges);
+    freeze();
+}
+
+void AuthorsGraph::freeze()
+{
+    if(frozen)
+    {
+        if(!snapshot && (!pendingEdges.empty() || nameOrderData.size() < (size_t)nodeCount))
+            mergePending(); // skladowe aktualizowane sa juz przez addPublications
+        return;
+    }
+
+    offsetsData.assign(nodeCount + 1, 0);
+
+    if(hasPapers()) // graf dwudzielny - listy wspolpracownikow rozwijane sa dopiero na zadanie (freezeCoAuthors)
+    {
+        buildAuthorPapers();
+        neighborsData.clear();
+    }
+    else
+    {
+        parallelFor(nodeCount, 4096, buildThreads, nullptr, [this](uint64_t begin, uint64_t end)
+        {
+            for(uint64_t i = begin; i < end; ++i) // sortowanie i usuwanie powtorzen z list wspolpracownikow
+            {
+                auto& list = coWritersLists[i];
+                sort(list.begin(), list.end());
+                list.erase(unique(list.begin(), list.end()), list.end());
+            }
+        });
+
+        for(int i = 0; i < nodeCount; ++i)
+            offsetsData[i+1] = offsetsData[i] + coWritersLists[i].size();
+
+        neighborsData.resize(offsetsData[nodeCount]);
+
+        parallelFor(nodeCount, 4096, buildThreads, nullptr, [this](uint64_t begin, uint64_t end)
+        {
+            for(uint64_t i = begin; i < end; ++i) // przepisanie list do jednej ciaglej tablicy
+            {
+                copy(coWritersLists[i].begin(), coWritersLists[i].end(), neighborsData.begin() + offsetsData[i]);
+                vector<AuthorId>().swap(coWritersLists[i]);
+            }
+        });
+
+        coAuthorLists = true;
+    }
+
+    finishFreeze();
+}
+
+void AuthorsGraph::finishFreeze()
+{
+    vector<vector<AuthorId>>().swap(coWritersLists);
+
+    if(vertexOrder != NATURAL_ORDER)
+        relabel(computeVertexOrder());
+
+    if(compressAdjacency && !hasPapers()) // CSR zastepowany listami skompresowanymi - rozwijany ponownie na zadanie
+    {
+        compressedLists.build(offsetsData.data(), neighborsData.data(), nodeCount, buildThreads);
+        vector<uint32_t>().swap(offsetsData);
+        vector<AuthorId>().swap(neighborsData);
+        coAuthorLists = false;
+    }
+
+    nameOrderData.resize(nodeCount); // porzadek alfabetyczny tablicy napisow
+    for(int i = 0; i < nodeCount; ++i)
+        nameOrderData[i] = i;
+
+    parallelSort(nameOrderData.begin(), nameOrderData.end(),
+                 [this](AuthorId a, AuthorId b) { return names.get(a) < names.get(b); }, buildThreads);
+
+    components.freeze();
+    attachOwnedData();
+    frozen = true;
+}
+
+vector<AuthorsGraph::AuthorId> AuthorsGraph::computeVertexOrder() const
+{
+    bool papers = hasPapers();
+    vector<uint32_t> degree(nodeCount); // liczba wspolpracownikow lub, w trybie dwudzielnym, publikacji autora
+    vector<AuthorId> order(nodeCount);
+
+    for(int a = 0; a < nodeCount; ++a)
+    {
+        degree[a] = papers ? authorPaperOffsets[a+1] - authorPaperOffsets[a] : offsetsData[a+1] - offsetsData[a];
+        order[a] = a;
+    }
+
+    auto descending = [&](AuthorId a, AuthorId b) { return degree[a] != degree[b] ? degree[a] > degree[b] : a < b; };
+    auto ascending = [&](AuthorId a, AuthorId b) { return degree[a] != degree[b] ? degree[a] < degree[b] : a < b; };
+    bool rcm = vertexOrder == RCM_ORDER;
+
+    if(vertexOrder == DEGREE_ORDER)
+    {
+        parallelSort(order.begin(), order.end(), descending, buildThreads);
+        return order;
+    }
+
+    //BFS: skladowe przegladane od centrow (najwiecej wspolpracownikow). Cuthill-McKee: od autorow peryferyjnych
+    //(najmniej wspolpracownikow), a nowo odwiedzeni wspolpracownicy kazdego autora dopisywani rosnaco wedlug liczby
+    //wspolpracownikow - kolejnosc jest na koniec odwracana
+    vector<AuthorId> seeds(order);
+    vector<char> visited(nodeCount, 0);
+    vector<char> expanded(getPublicationsCount(), 0);
+
+    parallelSort(seeds.begin(), seeds.end(), [&](AuthorId a, AuthorId b) { return rcm ? ascending(a, b) : descending(a, b); },
+                 buildThreads);
+    order.clear();
+
+    auto reach = [&](AuthorId m)
+    {
+        if(!visited[m])
+        {
+            visited[m] = 1;
+            order.push_back(m);
+        }
+    };
+
+    for(AuthorId seed: seeds)
+    {
+        if(visited[seed])
+            continue;
+
+        reach(seed);
+
+        for(size_t head = order.size() - 1; head < order.size(); ++head) // kolejka FIFO to sam wynik
+        {
+            AuthorId a = order[head];
+            size_t first = order.size();
+
+            if(papers) // kazda publikacja rozwijana raz, przy pierwszym autorze
+            {
+                for(uint32_t e = authorPaperOffsets[a]; e < authorPaperOffsets[a+1]; ++e)
+                    if(!expanded[authorPapers[e]])
+                    {
+                        expanded[authorPapers[e]] = 1;
+
+                        for(uint32_t m = paperOffsets[authorPapers[e]]; m < paperOffsets[authorPapers[e]+1]; ++m)
+                            reach(paperMembers[m]);
+                    }
+            }
+            else
+                for(uint32_t e = offsetsData[a]; e < offsetsData[a+1]; ++e)
+                    reach(neighborsData[e]);
+
+            if(rcm)
+                sort(order.begin() + first, order.end(), ascending);
+        }
+    }
+
+    if(rcm)
+        reverse(order.begin(), order.end());
+
+    return order;
+}
+
+void AuthorsGraph::relabel(vector<AuthorId> &&order)
+{
+    vector<AuthorId> newId(nodeCount);
+
+    for(int i = 0; i < nodeCount; ++i)
+        newId[order[i]] = i;
+
+    names.permute(order);
+    components.relabel(newId);
+
+    if(hasPapers()) // autorzy publikacji - numery publikacji sie nie zmieniaja
+    {
+        parallelFor(getPublicationsCount(), 4096, buildThreads, nullptr, [&](uint64_t begin, uint64_t end)
+        {
+            for(uint64_t paper = begin; paper < end; ++paper)
+            {
+                auto first = paperMembers.begin() + paperOffsets[paper], last = paperMembers.begin() + paperOffsets[paper+1];
+
+                for(auto m = first; m != last; ++m)
+                    *m = newId[*m];
+
+                sort(first, last);
+            }
+        });
+
+        buildAuthorPapers();
+    }
+    else
+    {
+        vector<uint32_t> relabeledOffsets(nodeCount + 1, 0);
+        vector<AuthorId> relabeledNeighbors(neighborsData.size());
+
+        for(int i = 0; i < nodeCount; ++i)
+            relabeledOffsets[i+1] = relabeledOffsets[i] + offsetsData[order[i]+1] - offsetsData[order[i]];
+
+        parallelFor(nodeCount, 4096, buildThreads, nullptr, [&](uint64_t begin, uint64_t end)
+        {
+            for(uint64_t i = begin; i < end; ++i) // lista autora order[i] staje sie lista i
+            {
+                auto out = relabeledNeighbors.begin() + relabeledOffsets[i];
+
+                for(uint32_t e = offsetsData[order[i]]; e < offsetsData[order[i]+1]; ++e)
+                    *out++ = newId[neighborsData[e]];
+
+                sort(relabeledNeighbors.begin() + relabeledOffsets[i], out);
+            }
+        });
+
+        offsetsData.swap(relabeledOffsets);
+        neighborsData.swap(relabeledNeighbors);
+    }
+
+    originalIdsData = move(order);
+}
+
+void AuthorsGraph::loadGraphParallel(const vector<vector<string>> &publications, bool createAuthors)
+{
+    //Blok publikacji przetwarzany przez jeden watek
+    struct Block
+    {
+        StringArena names; // nazwiska autorow bloku w kolejnosci pierwszego wystapienia (przy tworzeniu wezlow)
+        vector<uint64_t> pairs; // krawedzie skierowane (u << 32) | v - identyfikatory lokalne areny lub grafu
+        vector<uint64_t> links; // pierwszy autor publikacji i kolejny wspolautor - krawedzie laczace skladowe
+        vector<AuthorId> ids; // identyfikatory grafu nazwisk lokalnej areny
+    };
+
+    size_t count = publications.size();
+    size_t grain = max<size_t>(1024, (count + 8 * buildThreads - 1) / (8 * buildThreads));
+    vector<Block> blocks((count + grain - 1) / grain);
+
+    parallelFor(count, grain, buildThreads, progress, [&](uint64_t begin, uint64_t end)
+    {
+        Block& block = blocks[begin / grain];
+        vector<AuthorId> ids;
+        uint64_t edges = 0;
+        AuthorId id;
+
+        for(uint64_t i = begin; i < end; ++i)
+        {
+            ids.clear();
+
+            for(auto& name: publications[i])
+            {
+                if(createAuthors)
+                    ids.push_back(block.names.intern(name));
+                else if(names.find(name, id)) // arena grafu jest tylko odczytywana - bezpieczne wspolbieznie
+                    ids.push_back(id);
+            }
+
+            for(size_t j = 1; j < ids.size(); ++j)
+                block.links.push_back(uint64_t(ids[0]) << 32 | ids[j]);
+
+            for(size_t j = 0; j < ids.size(); ++j)
+                for(size_t k = j + 1; k < ids.size(); ++k)
+                {
+                    if(ids[j] == ids[k])
+                        continue;
+
+                    block.pairs.push_back(uint64_t(ids[j]) << 32 | ids[k]);
+                    block.pairs.push_back(uint64_t(ids[k]) << 32 | ids[j]);
+                }
+
+            edges += publicationEdges(publications[i].size());
+
+            if((i + 1 - begin) % PROGRESS_INTERVAL == 0)
+                reportProgress(0, exchange(edges, 0));
+        }
+
+        reportProgress(0, edges);
+    });
+
+    if(progress && progress->isCancelled())
+    {
+        clear();
+        return;
+    }
+
+    if(createAuthors) // scalanie aren w kolejnosci blokow - identyfikatory jak przy ladowaniu sekwencyjnym
+        for(auto& block: blocks)
+        {
+            block.ids.resize(block.names.size());
+
+            for(AuthorId local = 0; local < block.ids.size(); ++local)
+                block.ids[local] = addAuthor(block.names.get(local));
+
+            block.names = StringArena();
+        }
+
+    for(auto& block: blocks) // skladowe - sekwencyjnie, k-1 polaczen na publikacje
+    {
+        for(uint64_t link: block.links)
+        {
+            AuthorId u = link >> 32, v = link & 0xFFFFFFFF;
+            components.unite(createAuthors ? block.ids[u] : u, createAuthors ? block.ids[v] : v);
+        }
+
+        vector<uint64_t>().swap(block.links);
+    }
+
+    int idBits = 1;
+    while((uint64_t(1) << idBits) < (uint64_t)nodeCount)
+        ++idBits;
+
+    vector<uint64_t> starts(blocks.size() + 1, 0); // poczatki par blokow we wspolnej tablicy kluczy
+    for(size_t b = 0; b < blocks.size(); ++b)
+        starts[b+1] = starts[b] + blocks[b].pairs.size();
+
+    vector<uint64_t> keys(starts.back());
+
+    parallelFor(blocks.size(), 1, buildThreads, nullptr, [&](uint64_t b, uint64_t)
+    {
+        Block& block = blocks[b];
+        uint64_t* out = keys.data() + starts[b];
+
+        for(uint64_t pair: block.pairs)
+        {
+            uint64_t u = pair >> 32, v = pair & 0xFFFFFFFF;
+
+            if(createAuthors)
+            {
+                u = block.ids[u];
+                v = block.ids[v];
+            }
+
+            *out++ = u << idBits | v;
+        }
+
+        vector<uint64_t>().swap(block.pairs);
+    });
+
+    blocks.clear();
+
+    buildCSR(keys, idBits);
+    coAuthorLists = true;
+    finishFreeze();
+}
+
+void AuthorsGraph::buildCSR(vector<uint64_t> &keys, int idBits)
+{
+    uint64_t mask = (uint64_t(1) << idBits) - 1;
+    int slices = max(1, min<int>(buildThreads, keys.size() / 65536 + 1));
+    vector<uint64_t> kept(slices + 1, 0); // liczby roznych kluczy czesci tablicy, a nastepnie ich poczatki w CSR
+
+    parallelRadixSort(keys, 2 * idBits, buildThreads);
+
+    parallelSlices(keys.size(), slices, [&](uint64_t slice, uint64_t begin, uint64_t end)
+    {
+        for(uint64_t i = begin; i < end; ++i)
+            if(i == 0 || keys[i] != keys[i-1])
+                ++kept[slice + 1];
+    });
+
+    for(int s = 0; s < slices; ++s)
+        kept[s + 1] += kept[s];
+
+    offsetsData.assign(nodeCount + 1, 0);
+    neighborsData.resize(kept[slices]);
+
+    parallelSlices(keys.size(), slices, [&](uint64_t slice, uint64_t begin, uint64_t end)
+    {
+        uint64_t position = kept[slice];
+
+        for(uint64_t i = begin; i < end; ++i)
+        {
+            if(i > 0 && keys[i] == keys[i-1]) // powtorzona krawedz
+                continue;
+
+            //Pierwszy klucz autora wyznacza poczatki jego listy i list pustych autorow miedzy nim a poprzednim kluczem
+            int64_t previous = i == 0 ? -1 : int64_t(keys[i-1] >> idBits);
+            for(int64_t u = previous + 1; u <= int64_t(keys[i] >> idBits); ++u)
+                offsetsData[u] = position;
+
+            neighborsData[position++] = keys[i] & mask;
+        }
+    });
+
+    int64_t last = keys.empty() ? -1 : int64_t(keys.back() >> idBits);
+    for(int64_t u = last + 1; u <= nodeCount; ++u)
+        offsetsData[u] = neighborsData.size();
+
+    vector<uint64_t>().swap(keys);
+}
+
+void AuthorsGraph::freezeCoAuthors()
+{
+    freeze();
+
+    if(coAuthorLists)
+        return;
+
+    if(!compressedLists.empty()) // odczyt list skompresowanych do CSR - listy skompresowane pozostaja
+    {
+        offsetsData.assign(nodeCount + 1, 0);
+
+        for(int a = 0; a < nodeCount; ++a)
+            offsetsData[a+1] = offsetsData[a] + compressedLists.getDegree(a);
+
+        neighborsData.resize(offsetsData[nodeCount]);
+
+        parallelFor(nodeCount, 4096, buildThreads, nullptr, [this](uint64_t begin, uint64_t end)
+        {
+            for(uint64_t a = begin; a < end; ++a)
+                compressedLists.decode(a, neighborsData.data() + offsetsData[a]);
+        });
+
+        attachOwnedData();
+        coAuthorLists = true;
+        return;
+    }
+
+    //Rozwijanie publikacji w listy wspolpracownikow - znacznik last[m] == a pomija powtorzenia wspolautora m
+    vector<AuthorId> last(nodeCount, numeric_limits<AuthorId>::max());
+
+    neighborsData.clear();
+
+    for(int a = 0; a < nodeCount; ++a)
+    {
+        size_t begin = neighborsData.size();
+
+        for(uint32_t e = authorPaperOffsets[a]; e < authorPaperOffsets[a+1]; ++e)
+        {
+            uint32_t paper = authorPapers[e];
+
+            for(uint32_t m = paperOffsets[paper]; m < paperOffsets[paper+1]; ++m)
+            {
+                AuthorId coWorker = paperMembers[m];
+
+                if(coWorker != (AuthorId)a && last[coWorker] != (AuthorId)a)
+                {
+                    last[coWorker] = a;
+                    neighborsData.push_back(coWorker);
+                }
+            }
+        }
+
+        sort(neighborsData.begin() + begin, neighborsData.end());
+        offsetsData[a+1] = neighborsData.size();
+    }
+
+    attachOwnedData();
+    coAuthorLists = true;
+}
+
+void AuthorsGraph::buildAuthorPapers()
+{
+    size_t paperCount = paperOffsets.size() - 1;
+
+    authorPaperOffsets.assign(nodeCount + 1, 0);
+
+    for(auto author: paperMembers) // liczba publikacji autorow
+        ++authorPaperOffsets[author + 1];
+
+    for(int a = 0; a < nodeCount; ++a)
+        authorPaperOffsets[a+1] += authorPaperOffsets[a];
+
+    vector<uint32_t> next(authorPaperOffsets.begin(), authorPaperOffsets.end() - 1); // kolejne wolne miejsca list
+    authorPapers.resize(paperMembers.size());
+
+    for(size_t paper = 0; paper < paperCount; ++paper) // listy publikacji autorow w kolejnosci rosnacej
+        for(uint32_t m = paperOffsets[paper]; m < paperOffsets[paper+1]; ++m)
+            authorPapers[next[paperMembers[m]]++] = paper;
+}
+
+void AuthorsGraph::attachOwnedData()
+{
+    offsets = offsetsData.data();
+    neighbors = neighborsData.data();
+    edgeEntries = neighborsData.size();
+    nameOffsets = names.offsetsData();
+    nameOrder = nameOrderData.data();
+    nameChars = names.charsData();
+    originalIds = originalIdsData.data();
+    originalIdsCount = originalIdsData.size();
+}
+
+void AuthorsGraph::detachSnapshot()
+{
+    offsetsData.assign(offsets, offsets + nodeCount + 1);
+    neighborsData.assign(neighbors, neighbors + edgeEntries);
+    nameOrderData.assign(nameOrder, nameOrder + nodeCount);
+    originalIdsData.assign(originalIds, originalIds + originalIdsCount);
+    components.detach();
+
+    for(int i = 0; i < nodeCount; ++i) // nazwiska migawki sa unikalne, wiec arena nada te same identyfikatory
+        names.intern(getName(i));
+
+    snapshot.reset();
+    attachOwnedData();
+}
+
+void AuthorsGraph::mergePending()
+{
+    vector<uint32_t> mergedOffsets(nodeCount + 1, 0);
+    vector<AuthorId> mergedNeighbors;
+    size_t pendingEntries = 0;
+
+    for(auto& pending: pendingEdges)
+    {
+        auto& list = pending.second;
+        sort(list.begin(), list.end());
+        list.erase(unique(list.begin(), list.end()), list.end());
+        pendingEntries += list.size();
+    }
+
+    mergedNeighbors.reserve(edgeEntries + pendingEntries);
+
+    for(int i = 0; i < nodeCount; ++i) // scalanie posortowanych list - CSR i oczekujacej - bez powtorzen
+    {
+        auto found = pendingEdges.find(i);
+
+        if(found == pendingEdges.end())
+            mergedNeighbors.insert(mergedNeighbors.end(), neighbors + offsets[i], neighbors + offsets[i+1]);
+        else
+            set_union(neighbors + offsets[i], neighbors + offsets[i+1], found->second.begin(), found->second.end(),
+                      back_inserter(mergedNeighbors));
+
+        mergedOffsets[i+1] = mergedNeighbors.size();
+    }
+
+    size_t sorted = nameOrderData.size(); // nowi autorzy dolaczaja do porzadku alfabetycznego
+    auto byName = [this](AuthorId a, AuthorId b) { return names.get(a) < names.get(b); };
+
+    for(AuthorId i = sorted; i < (AuthorId)nodeCount; ++i)
+        nameOrderData.push_back(i);
+
+    sort(nameOrderData.begin() + sorted, nameOrderData.end(), byName);
+    inplace_merge(nameOrderData.begin(), nameOrderData.begin() + sorted, nameOrderData.end(), byName);
+
+    offsetsData.swap(mergedOffsets);
+    neighborsData.swap(mergedNeighbors);
+    pendingEdges.clear();
+    attachOwnedData();
+}
+
+bool AuthorsGraph::findAuthor(string_view name, AuthorId &id) const
+{
+    if(!snapshot) // graf z wlasna arena - wyszukiwanie w indeksie mieszajacym
+        return names.find(name, id);
+
+    //Graf z migawki - wyszukiwanie binarne w porzadku alfabetycznym tablicy napisow
+    auto found = lower_bound(nameOrder, nameOrder + nodeCount, name,
+                             [this](AuthorId a, string_view n) { return getName(a) < n; });
+
+    if(found == nameOrder + nodeCount || getName(*found) != name)
+        return false;
+
+    id = *found;
+    return true;
+}
+
+bool AuthorsGraph::findPath(string_view from, string_view to, Path &path)
+{
+    AuthorId a, b;
+
+    freeze();
+
+    if(!findAuthor(from, a) || !findAuthor(to, b))
+        return false;
+
+    findPath(a, b, path);
+    return true;
+}
+
+void AuthorsGraph::findPath(AuthorId from, AuthorId to, Path &path)
+{
+    const uint32_t NO_PUBLICATION = numeric_limits<uint32_t>::max();
+
+    freeze();
+
+    path.authors.clear();
+    path.publications.clear();
+
+    if(!components.isConnected(from, to)) // rozne skladowe - odpowiedz bez przeszukiwania
+    {
+        path.distance = INFINITE_RANK;
+        path.visited = 0;
+        return;
+    }
+
+    TraversalPool::Lease workspace = traversals.acquire(); // pamiec robocza wielokrotnego uzytku - zapytanie nie alokuje
+    TraversalSide* sides = workspace->sides; // strona 0 - od autora poczatkowego, strona 1 - od koncowego
+    vector<AuthorId>& next = workspace->next;
+    vector<AuthorId>& decoded = workspace->decoded;
+    AuthorId meet[2] = {from, to}; // autorzy stron polaczeni krawedzia spotkania
+    uint32_t meetPublication = NO_PUBLICATION;
+    int best = from == to ? 0 : INFINITE_RANK;
+
+    for(int side = 0; side < 2; ++side)
+    {
+        AuthorId source = side == 0 ? from : to;
+
+        sides[side].start(nodeCount, hasPapers() ? paperOffsets.size() - 1 : 0);
+        sides[side].visit(source, source, NO_PUBLICATION, 0);
+        sides[side].frontier.push_back(source);
+    }
+
+    if(decoded.size() < compressedLists.getMaxDegree())
+        decoded.resize(compressedLists.getMaxDegree());
+
+    while(best == INFINITE_RANK && !sides[0].frontier.empty() && !sides[1].frontier.empty())
+    {
+        int side = sides[0].frontier.size() <= sides[1].frontier.size() ? 0 : 1; // rozwijany jest mniejszy front
+        TraversalSide& mine = sides[side];
+        TraversalSide& other = sides[1 - side];
+
+        next.clear();
+
+        for(AuthorId a: mine.frontier)
+        {
+            int nextDistance = mine.distance[a] + 1;
+
+            auto visit = [&](AuthorId b, uint32_t publication)
+            {
+                if(other.isVisited(b) && nextDistance + (int)other.distance[b] < best) // fronty sie spotkaly
+                {
+                    best = nextDistance + other.distance[b];
+                    meet[side] = a;
+                    meet[1 - side] = b;
+                    meetPublication = publication;
+                }
+
+                if(mine.visit(b, a, publication, nextDistance))
+                    next.push_back(b);
+            };
+
+            if(hasPapers()) // graf dwudzielny - kazda publikacja rozwijana jest przez strone raz
+            {
+                for(uint32_t e = authorPaperOffsets[a]; e < authorPaperOffsets[a+1]; ++e)
+                {
+                    uint32_t paper = authorPapers[e];
+
+                    if(mine.expand(paper))
+                        for(uint32_t m = paperOffsets[paper]; m < paperOffsets[paper+1]; ++m)
+                            if(paperMembers[m] != a)
+                                visit(paperMembers[m], paper);
+                }
+            }
+            else
+                forEachCoAuthor(a, decoded, [&](AuthorId b) { visit(b, NO_PUBLICATION); });
+        }
+
+        mine.frontier.swap(next); // spotkanie w tej warstwie daje najkrotszy lancuch - petla sie konczy
+    }
+
+    path.distance = best;
+    path.visited = sides[0].visitedCount + sides[1].visitedCount - (from == to);
+
+    if(best == INFINITE_RANK)
+        return;
+
+    //Lancuch: od autora poczatkowego do meet[0] (odwrocona sciezka rodzicow strony 0), nastepnie od meet[1] do koncowego
+    for(AuthorId a = meet[0]; ; a = sides[0].parent[a])
+    {
+        path.authors.push_back(a);
+
+        if(a == from)
+            break;
+
+        path.publications.push_back(sides[0].publication[a]);
+    }
+
+    reverse(path.authors.begin(), path.authors.end());
+    reverse(path.publications.begin(), path.publications.end());
+
+    if(meet[0] != meet[1])
+    {
+        path.publications.push_back(meetPublication);
+
+        for(AuthorId a = meet[1]; ; a = sides[1].parent[a])
+        {
+            path.authors.push_back(a);
+
+            if(a == to)
+                break;
+
+            path.publications.push_back(sides[1].publication[a]);
+        }
+    }
+
+    if(!hasPapers())
+        path.publications.clear();
+}
+
+bool AuthorsGraph::saveSnapshot(const string &path)
+{
+    SnapshotHeader header;
 
-    vector<Author*> coAuthors; //Wektor wspolautorow
-    shared_ptr<Author> authorPtr;
+    freezeCoAuthors();
 
-    if(!authorsMap.empty())
-        authorsMap.clear();
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.endianness = SNAPSHOT_ENDIANNESS;
+    header.nodeCount = nodeCount;
+    header.edgeEntries = edgeEntries;
+    header.nameBytes = nameOffsets[nodeCount];
+    header.offsetsPos = align8(sizeof(header));
+    header.neighborsPos = align8(header.offsetsPos + (header.nodeCount + 1) * sizeof(uint32_t));
+    header.nameOffsetsPos = align8(header.neighborsPos + header.edgeEntries * sizeof(AuthorId));
+    header.nameOrderPos = align8(header.nameOffsetsPos + (header.nodeCount + 1) * sizeof(uint32_t));
+    header.componentsPos = align8(header.nameOrderPos + header.nodeCount * sizeof(AuthorId));
+    header.componentSizesPos = align8(header.componentsPos + header.nodeCount * sizeof(uint32_t));
+    header.originalIdsPos = align8(header.componentSizesPos + components.getSlotsCount() * sizeof(uint32_t));
+    header.nameCharsPos = align8(header.originalIdsPos + originalIdsCount * sizeof(AuthorId));
+    header.componentSlots = components.getSlotsCount();
+    header.componentsCount = components.getComponentsCount();
+    header.largestComponent = components.getLargestSize();
+    header.isolatedAuthors = components.getIsolatedCount();
+    header.originalIdsCount = originalIdsCount;
+    header.fileSize = header.nameCharsPos + header.nameBytes;
 
-    for(auto i :authors) //Ladowanie wezlow na podstawie listy autorow
+    ofstream file(path, ios::binary | ios::trunc);
+    if(!file)
+        return false;
+
+    auto writeSection = [&](uint64_t pos, const void* data, uint64_t bytes)
     {
-        authorsMap.emplace(i, shared_ptr<Author> (new Author(nodeCount,i)));
-        ++nodeCount;
+        static const char padding[8] = {0};
+        file.write(padding, pos - file.tellp());
+        file.write(static_cast<const char*>(data), bytes);
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeSection(header.offsetsPos, offsets, (header.nodeCount + 1) * sizeof(uint32_t));
+    writeSection(header.neighborsPos, neighbors, header.edgeEntries * sizeof(AuthorId));
+    writeSection(header.nameOffsetsPos, nameOffsets, (header.nodeCount + 1) * sizeof(uint32_t));
+    writeSection(header.nameOrderPos, nameOrder, header.nodeCount * sizeof(AuthorId));
+    writeSection(header.componentsPos, components.componentsData(), header.nodeCount * sizeof(uint32_t));
+    writeSection(header.componentSizesPos, components.sizesData(), header.componentSlots * sizeof(uint32_t));
+    writeSection(header.originalIdsPos, originalIds, header.originalIdsCount * sizeof(AuthorId));
+    writeSection(header.nameCharsPos, nameChars, header.nameBytes);
+
+    return bool(file.flush());
+}
+
+bool AuthorsGraph::loadSnapshot(const string &path)
+{
+    SnapshotHeader header;
+    auto file = make_shared<MappedFile>();
+
+    if(!file->open(path) || file->size() < sizeof(header))
+        return false;
+
+    memcpy(&header, file->data(), sizeof(header));
+
+    //Weryfikacja naglowka i polozenia sekcji - dane sekcji nie sa kopiowane ani przegladane
+    if(memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION ||
+       header.endianness != SNAPSHOT_ENDIANNESS || header.fileSize != file->size() ||
+       header.nodeCount >= (uint64_t)numeric_limits<int>::max() ||
+       !sectionFits(header.offsetsPos, header.nodeCount + 1, sizeof(uint32_t), header.fileSize) ||
+       !sectionFits(header.neighborsPos, header.edgeEntries, sizeof(AuthorId), header.fileSize) ||
+       !sectionFits(header.nameOffsetsPos, header.nodeCount + 1, sizeof(uint32_t), header.fileSize) ||
+       !sectionFits(header.nameOrderPos, header.nodeCount, sizeof(AuthorId), header.fileSize) ||
+       !sectionFits(header.componentsPos, header.nodeCount, sizeof(uint32_t), header.fileSize) ||
+       !sectionFits(header.componentSizesPos, header.componentSlots, sizeof(uint32_t), header.fileSize) ||
+       header.componentSlots > header.nodeCount || header.componentsCount > header.componentSlots ||
+       header.largestComponent > header.nodeCount || header.isolatedAuthors > header.componentsCount ||
+       header.originalIdsCount > header.nodeCount ||
+       !sectionFits(header.originalIdsPos, header.originalIdsCount, sizeof(AuthorId), header.fileSize) ||
+       !sectionFits(header.nameCharsPos, header.nameBytes, 1, header.fileSize))
+        return false;
+
+    const char* base = file->data();
+    auto mappedOffsets = reinterpret_cast<const uint32_t*>(base + header.offsetsPos);
+    auto mappedNameOffsets = reinterpret_cast<const uint32_t*>(base + header.nameOffsetsPos);
+
+    if(mappedOffsets[header.nodeCount] != header.edgeEntries || mappedNameOffsets[header.nodeCount] != header.nameBytes)
+        return false;
+
+    clear();
+    paperOffsets.clear(); // migawka zawiera listy wspolpracownikow, rowniez w trybie dwudzielnym
+
+    snapshot = file;
+    nodeCount = header.nodeCount;
+    offsets = mappedOffsets;
+    neighbors = reinterpret_cast<const AuthorId*>(base + header.neighborsPos);
+    edgeEntries = header.edgeEntries;
+    nameOffsets = mappedNameOffsets;
+    nameOrder = reinterpret_cast<const AuthorId*>(base + header.nameOrderPos);
+    nameChars = base + header.nameCharsPos;
+    originalIds = reinterpret_cast<const AuthorId*>(base + header.originalIdsPos);
+    originalIdsCount = header.originalIdsCount;
+    frozen = true;
+    coAuthorLists = true;
+
+    components.attach(reinterpret_cast<const uint32_t*>(base + header.componentsPos), nodeCount,
+                      reinterpret_cast<const uint32_t*>(base + header.componentSizesPos), header.componentSlots,
+                      header.componentsCount, header.largestComponent, header.isolatedAuthors);
+
+    return true;
+}
+
+size_t AuthorsGraph::getAdjacencyBytes() const
+{
+    size_t bytes = compressedLists.getBytes() +
+            (paperOffsets.size() + paperMembers.size() + authorPaperOffsets.size() + authorPapers.size()) * sizeof(uint32_t);
+
+    if(coAuthorLists) // CSR wlasny lub odwzorowany z migawki
+        bytes += (nodeCount + 1) * sizeof(uint32_t) + edgeEntries * sizeof(AuthorId);
+
+    return bytes;
+}
+
+AuthorsGraph::RankList *AuthorsGraph::makeResult(vector<int> &&distance) const
+{
+    return new RankList(this, move(distance)); // kolejnosc alfabetyczna i nazwiska odczytywane sa z tablicy napisow
+}
+
+AuthorsGraph::RankList *AuthorsGraph::getRanksBFS()
+{
+    AuthorId root;
+
+    freeze();
+
+    if(!findRoot(root)) //Wyszukiwanie wezla startowego algorytmu - Erdosa
+        return makeResult(vector<int>(nodeCount, INFINITE_RANK));
+
+    vector<int> *distance = getDistancesBFS(root);
+
+    if(!distance) // przerwane zadanie
+        return nullptr;
+
+    RankList *result = makeResult(move(*distance));
+    delete distance;
+
+    return result;
+}
+
+vector<int> *AuthorsGraph::getDistancesBFS(AuthorId root)
+{
+    freeze();
+
+    TraversalPool::Lease workspace = traversals.acquire(); // kolejka i bufor z puli - alokowany jest jedynie wynik
+    vector<AuthorId> &Queue = workspace->next; // kolejka FIFO - wezly sa dopisywane na koniec, a czytane od poczatku
+    vector<AuthorId> &decoded = workspace->decoded; // bufor odczytu list skompresowanych
+    vector<int> *result = new vector<int>(nodeCount, INFINITE_RANK);
+    vector<int> &distance = *result;
+
+    if(decoded.size() < compressedLists.getMaxDegree())
+        decoded.resize(compressedLists.getMaxDegree());
+
+    Queue.clear();
+    Queue.reserve(components.getComponentSize(root)); // kolejka obejmie dokladnie skladowa autora
+    distance[root] = 0;
+    Queue.push_back(root);
+
+    if(hasPapers()) // graf dwudzielny - przejscie przez publikacje
+    {
+        if(bipartiteBFS(distance, Queue, workspace->sides[0]))
+            return result;
+
+        delete result;
+        return nullptr;
     }
 
-    for (auto i: publications) // ladowanie krawedzi grafow na podstawie publikacji
+    for(size_t head = 0; head < Queue.size(); ++head) //Dodawaj kolejnych wspolpracownikow i nadawaj im rangi o 1 wieksze
     {
-        auto iter = i.begin();
-        auto end = i.end();
+        AuthorId a = Queue[head];
+        int nextRank = distance[a] + 1;
 
+        forEachCoAuthor(a, decoded, [&](AuthorId i)
+        {
+            if(distance[i] == INFINITE_RANK)
+            {
+                distance[i] = nextRank;
+                Queue.push_back(i);
+            }
+        });
 
-        for(;iter!=end;++iter) // wyszukiwanie autorow wymienionych w publikacji ...
+        if((head + 1) % PROGRESS_INTERVAL == 0 && !reportProgress(PROGRESS_INTERVAL, 0))
         {
-           authorPtr = authorsMap.find(*iter)->second;
-           coAuthors.push_back(authorPtr.get());
+            delete result;
+            return nullptr;
         }
+    }
 
-        for(auto j = coAuthors.begin(); j != coAuthors.end(); ++j) // ... i dodawanie odpowiednich krawedzi
-            for(auto k = j+1; k != coAuthors.end(); ++k)
+    reportProgress(Queue.size() % PROGRESS_INTERVAL, 0);
+    return result;
+}
+
+bool AuthorsGraph::bipartiteBFS(vector<int> &distance, vector<AuthorId> &queue, TraversalSide &side)
+{
+    side.start(0, getPublicationsCount()); // potrzebne sa jedynie znaczniki publikacji - bez zerowania tablic
+
+    for(size_t head = 0; head < queue.size(); ++head)
+    {
+        AuthorId a = queue[head];
+        int nextRank = distance[a] + 1;
+
+        for(uint32_t e = authorPaperOffsets[a]; e < authorPaperOffsets[a+1]; ++e) // kazda publikacja rozwijana jest raz
+        {
+            uint32_t paper = authorPapers[e];
+
+            if(!side.expand(paper)) // publikacja, ktorej autorzy zostali juz odwiedzeni
+                continue;
+
+            for(uint32_t m = paperOffsets[paper]; m < paperOffsets[paper+1]; ++m)
             {
-                (*j)->addEdge(*k);
-                (*k)->addEdge(*j);
+                AuthorId i = paperMembers[m];
+                if(distance[i] == INFINITE_RANK)
+                {
+                    distance[i] = nextRank;
+                    queue.push_back(i);
+                }
             }
+        }
 
-        coAuthors.clear();
+        if((head + 1) % PROGRESS_INTERVAL == 0 && !reportProgress(PROGRESS_INTERVAL, 0))
+            return false;
     }
 
+    reportProgress(queue.size() % PROGRESS_INTERVAL, 0);
+    return true;
 }
 
-void AuthorsGraph::loadGraph(vector<vector<string> > &publications)
+template<int W>
+bool AuthorsGraph::multiSourceBFS(const AuthorId *roots, size_t count, vector<int> *distances, vector<AuthorId> &decoded) const
 {
-    vector<Author*> coAuthors; // wektor wspolpracownikow
-
-    if(!authorsMap.empty())
-        authorsMap.clear();
+    //Maski W slow na autora, bit i - zrodlo roots[i]
+    vector<uint64_t> seen(size_t(nodeCount) * W, 0); // zrodla, ktore juz osiagnely autora
+    vector<uint64_t> visit(size_t(nodeCount) * W, 0); // zrodla, ktorych biezaca warstwa zawiera autora
+    vector<uint64_t> visitNext(size_t(nodeCount) * W, 0); // zrodla, ktorych nastepna warstwa zawiera autora
 
-    for (auto i: publications)
+    for(size_t i = 0; i < count; ++i)
     {
-        auto iter = i.begin();
-        auto end = i.end();
+        AuthorId r = roots[i];
+        uint64_t bit = uint64_t(1) << (i & 63);
 
+        distances[i].assign(nodeCount, INFINITE_RANK);
+        distances[i][r] = 0;
+        seen[size_t(r) * W + i / 64] |= bit;
+        visit[size_t(r) * W + i / 64] |= bit;
+    }
 
-        for(;iter!=end;++iter) //ladowanie wezlow bez powtorzen w oparciu o dana publikacje
+    for(int level = 1; ; ++level)
+    {
+        for(int a = 0; a < nodeCount; ++a) // rozwijanie warstwy - wspolpracownicy dziedzicza maske frontu autora
         {
-           string name = *iter;
-           auto pair = authorsMap.emplace(name, shared_ptr<Author> (new Author(nodeCount,name)));
-           if(pair.second)
-           {
-               ++nodeCount;
-           }
+            const uint64_t *mask = &visit[size_t(a) * W];
+            uint64_t active = 0;
+            for(int w = 0; w < W; ++w)
+                active |= mask[w];
 
-           coAuthors.push_back((*(pair.first)).second.get());
+            if(!active)
+                continue;
+
+            forEachCoAuthor(a, decoded, [&](AuthorId b)
+            {
+                uint64_t *next = &visitNext[size_t(b) * W];
+                for(int w = 0; w < W; ++w)
+                    next[w] |= mask[w];
+            });
         }
 
-        for(auto j = coAuthors.begin(); j != coAuthors.end(); ++j) // dodawanie krawedzi
-            for(auto k = j+1; k != coAuthors.end(); ++k)
+        uint64_t reached = 0;
+
+        for(int v = 0; v < nodeCount; ++v) // pozostaw w nastepnej warstwie tylko zrodla, ktore osiagnely autora po raz pierwszy
+        {
+            uint64_t *next = &visitNext[size_t(v) * W];
+            uint64_t *known = &seen[size_t(v) * W];
+
+            for(int w = 0; w < W; ++w)
             {
-                (*j)->addEdge(*k);
-                (*k)->addEdge(*j);
+                uint64_t fresh = next[w] & ~known[w];
+                next[w] = fresh;
+                known[w] |= fresh;
+                reached |= fresh;
+
+                for(; fresh; fresh &= fresh - 1)
+                    distances[w * 64 + lowestBit(fresh)][v] = level;
             }
+        }
 
-        coAuthors.clear();
+        if(!reached)
+            break;
+
+        if(!reportProgress(nodeCount, 0)) // kazda warstwa przeglada wszystkich autorow
+            return false;
+
+        visit.swap(visitNext);
+        fill(visitNext.begin(), visitNext.end(), 0);
+    }
+
+    return true;
+}
+
+vector<vector<int>> *AuthorsGraph::getDistancesMultiSourceBFS(const vector<AuthorId> &roots)
+{
+    vector<vector<int>> *result = new vector<vector<int>>(roots.size());
+
+    freezeNeighborLists();
+
+    TraversalPool::Lease workspace = traversals.acquire(); // bufor odczytu list skompresowanych
+    vector<AuthorId> &decoded = workspace->decoded;
+
+    if(decoded.size() < compressedLists.getMaxDegree())
+        decoded.resize(compressedLists.getMaxDegree());
+
+    for(size_t first = 0; first < roots.size(); first += MULTI_SOURCE_WIDTH) // przebiegi po co najwyzej MULTI_SOURCE_WIDTH zrodel
+    {
+        size_t count = min(MULTI_SOURCE_WIDTH, roots.size() - first);
+        bool completed;
+
+        if(count <= 64)
+            completed = multiSourceBFS<1>(&roots[first], count, &(*result)[first], decoded);
+        else if(count <= 128)
+            completed = multiSourceBFS<2>(&roots[first], count, &(*result)[first], decoded);
+        else
+            completed = multiSourceBFS<4>(&roots[first], count, &(*result)[first], decoded);
+
+        if(!completed)
+        {
+            delete result;
+            return nullptr;
+        }
     }
+
+    return result;
 }
 
-vector<pair<string, int> > *AuthorsGraph::getRanksBFS()
+AuthorsGraph::RankList *AuthorsGraph::addPublications(const vector<vector<string>> &publications)
 {
+    vector<AuthorId> changed; // autorzy, ktorych ranga sie zmniejszyla
+    vector<AuthorId> coAuthors;
+    BucketQueue improved; // autorzy z poprawiona ranga, od ktorych propagowane jest zmniejszenie
+    AuthorId root;
+    AuthorId author;
+    int rank;
+
+    if(!frozen) // oczekujace krawedzie nie sa scalane - koszt wstawienia nie zalezy od rozmiaru grafu
+        freeze();
+
+    if(hasPapers()) // nowe krawedzie trafiaja do list wspolpracownikow - graf przestaje przechowywac publikacje
+    {
+        freezeCoAuthors();
+        vector<uint32_t>().swap(paperOffsets);
+        vector<AuthorId>().swap(paperMembers);
+        vector<uint32_t>().swap(authorPaperOffsets);
+        vector<uint32_t>().swap(authorPapers);
+    }
 
-    vector<pair<string,int> > *result = new vector<pair<string,int> > ();
-    Author * a;
-    shared_ptr<Author> erdos;
-    queue<Author*> Queue;
-    int currentRank;
+    if(!compressedLists.empty()) // nowe krawedzie scalane sa z CSR - graf wraca do list nieskompresowanych
+    {
+        freezeCoAuthors();
+        compressedLists.clear();
+    }
 
-    erdos = authorsMap.find("Erdos")->second; //Wyszukiwanie wezla startowego algorytmu - Erdosa
-    erdos->setRank(0);
+    if(snapshot)
+        detachSnapshot();
 
-    for(auto i: erdos->coWritersList) //Dodanie wspolpracownikow Erdosa do kolejki i nadanie im rangi 1
+    if(maintainedRanks.empty()) // rangi grafu sprzed dodania publikacji
     {
-            i->setRank(1);
-            Queue.push(i);
+        if(findRoot(root))
+        {
+            vector<int> *distance = getDistancesBFS(root);
+
+            if(!distance) // przerwane zadanie - rangi pozostaja puste i zostana wyznaczone przy nastepnym wywolaniu
+                return nullptr;
+
+            maintainedRanks.swap(*distance);
+            delete distance;
+        }
+        else
+            maintainedRanks.assign(nodeCount, INFINITE_RANK);
     }
 
-    while(! Queue.empty()) //Dodawaj kolejnych wspolpracownikow i nadawaj im rangi o 1 wieksze
+    auto relax = [&](AuthorId from, AuthorId to)
+    {
+        if(maintainedRanks[from] != INFINITE_RANK && maintainedRanks[from] + 1 < maintainedRanks[to])
+        {
+            maintainedRanks[to] = maintainedRanks[from] + 1;
+            changed.push_back(to);
+            improved.push(maintainedRanks[to], to);
+        }
+    };
+
+    for(auto& publication: publications)
     {
-        a = Queue.front();
-        Queue.pop();
-        currentRank = a->getRank();
+        coAuthors.clear();
 
-        for(auto i: a->coWritersList)
+        for(auto& name: publication)
         {
-            if(!i->isRanked())
+            AuthorId id = names.intern(name);
+
+            if(id == (AuthorId)nodeCount) // nowy autor - pusta lista w CSR, ranga nieskonczona
             {
-                i->setRank(currentRank + 1);
-                Queue.push(i);
+                ++nodeCount;
+                components.addAuthor();
+                offsetsData.push_back(offsetsData.back());
+                maintainedRanks.push_back(INFINITE_RANK);
             }
+
+            coAuthors.push_back(id);
         }
+
+        for(auto j = coAuthors.begin(); j != coAuthors.end(); ++j) // nowe krawedzie i poprawa rang ich koncow
+            for(auto k = j+1; k != coAuthors.end(); ++k)
+            {
+                if(*j == *k)
+                    continue;
+
+                pendingEdges[*j].push_back(*k);
+                pendingEdges[*k].push_back(*j);
+                components.unite(*j, *k);
+                relax(*j, *k);
+                relax(*k, *j);
+            }
     }
 
-    for(auto it: authorsMap) // generowanie par nazwisko-ranga
+    attachOwnedData();
+
+    if(findRoot(root) && maintainedRanks[root] != 0) // autor zrodlowy pojawil sie dopiero w tej partii
     {
-        string name = it.second->getName();
-        int rank = it.second->getRank();
-        result->push_back(make_pair(name,rank));
+        maintainedRanks[root] = 0;
+        changed.push_back(root);
+        improved.push(0, root);
     }
 
-    return result;
+    while(!improved.empty()) // propagacja zmniejszen w kolejnosci rosnacych rang
+    {
+        improved.pop(rank, author);
+
+        if(rank > maintainedRanks[author]) // nieaktualny wpis
+            continue;
+
+        for(uint32_t e = offsets[author]; e < offsets[author+1]; ++e)
+            relax(author, neighbors[e]);
+
+        auto found = pendingEdges.find(author);
+        if(found != pendingEdges.end())
+            for(auto coWorker: found->second)
+                relax(author, coWorker);
+    }
+
+    sort(changed.begin(), changed.end());
+    changed.erase(unique(changed.begin(), changed.end()), changed.end());
+    sort(changed.begin(), changed.end(), [this](AuthorId a, AuthorId b) { return getName(a) < getName(b); });
+
+    vector<int> ranks(changed.size());
+    for(size_t i = 0; i < changed.size(); ++i)
+        ranks[i] = maintainedRanks[changed[i]];
+
+    return new RankList(this, move(changed), move(ranks));
 }
 
-vector<pair<string,int> > *AuthorsGraph::getRanksDijkstry()
+AuthorsGraph::RankList *AuthorsGraph::getRanksDirectionOptimizingBFS()
 {
-    vector<pair<string,int> > *result = new vector<pair<string,int> > ();
-    map<string,int> minDistance; // zbior rang/odlegosci wezlow od erdosa
-    set< pair<int,string> > activeVer; //zbior wezlow do rozpatrzenia
+    AuthorId root;
+    bool bottomUp = false;
+
+    freezeNeighborLists();
+
+    TraversalPool::Lease workspace = traversals.acquire(); // mapy bitowe z puli - zerowane, ale bez alokacji
+    Bitmap &visited = workspace->layers[0]; // odwiedzeni autorzy
+    Bitmap &frontier = workspace->layers[1]; // biezaca warstwa
+    Bitmap &next = workspace->layers[2]; // nastepna warstwa
+    vector<AuthorId> &decoded = workspace->decoded; // bufor odczytu list skompresowanych
+    vector<int> distance(nodeCount, INFINITE_RANK);
+
+    if(decoded.size() < compressedLists.getMaxDegree())
+        decoded.resize(compressedLists.getMaxDegree());
 
-    for(auto it: authorsMap) //przydziel wezlom INT_MAX jako odlegosc do Erdosa, Erdosowi przydziel 0
+    visited.resize(nodeCount);
+    frontier.resize(nodeCount);
+    next.resize(nodeCount);
+
+    if(!findRoot(root))
+        return makeResult(move(distance));
+
+    uint64_t unexploredEdges = compressedLists.empty() ? edgeEntries : compressedLists.getEntries(); // suma stopni nieodwiedzonych autorow
+    uint64_t frontierEdges = coAuthorCount(root); // suma stopni autorow we froncie
+    int level = 0;
+
+    distance[root] = 0;
+    visited.set(root);
+    frontier.set(root);
+    unexploredEdges -= frontierEdges;
+
+    while(frontier.any())
     {
-        if(it.first =="Erdos")
-            minDistance.emplace("Erdos",0);
-        else
-            minDistance.emplace(it.first, numeric_limits<int>::max());
+        //Wybor kierunku dla nastepnej warstwy
+        if(!bottomUp && frontierEdges > unexploredEdges / DO_ALPHA)
+            bottomUp = true;
+        else if(bottomUp && frontier.count() < (size_t)nodeCount / DO_BETA)
+            bottomUp = false;
+
+        int nextRank = level + 1;
+        frontierEdges = 0;
+        next.clear();
+
+        if(bottomUp) // kazdy nieodwiedzony autor szuka wspolpracownika z biezacej warstwy (dlugie listy - jadro AVX2)
+        {
+            visited.forEachUnset([&](size_t v)
+            {
+                uint32_t degree;
+                const AuthorId *list = coAuthorList(v, decoded, degree);
+
+                if(frontier.testAny(list, degree))
+                {
+                    distance[v] = nextRank;
+                    next.set(v);
+                    frontierEdges += degree;
+                }
+            });
+
+            visited.orWith(next);
+        }
+        else // klasyczne rozwijanie frontu
+        {
+            frontier.forEachSet([&](size_t a)
+            {
+                forEachCoAuthor(a, decoded, [&](AuthorId i)
+                {
+                    if(!visited.test(i))
+                    {
+                        distance[i] = nextRank;
+                        visited.set(i);
+                        next.set(i);
+                        frontierEdges += coAuthorCount(i);
+                    }
+                });
+            });
+        }
+
+        unexploredEdges -= frontierEdges;
+        frontier.swap(next);
+        ++level;
+
+        if(!reportProgress(frontier.count(), 0))
+            return nullptr;
+    }
+
+    return makeResult(move(distance));
+}
+
+AuthorsGraph::RankList *AuthorsGraph::getRanksParallelBFS(int threadCount)
+{
+    vector<int> result(nodeCount, INFINITE_RANK);
+    AuthorId root;
+
+    freezeNeighborLists();
+
+    if(!findRoot(root))
+        return makeResult(move(result));
+
+    if(threadCount < 1)
+        threadCount = 1;
+
+    TraversalPool::Lease workspace = traversals.acquire(); // watki, rangi i fronty z puli - zachowywane pomiedzy zapytaniami
+    vector<AuthorId> &frontier = workspace->next; // biezaca warstwa, wspolna dla watkow
+    auto &threads = workspace->threads;
+    Barrier barrier(threadCount);
+    int level = 0;
+    bool stopped = false; // przerwane zadanie - ustawiane przez watek 0 pomiedzy barierami
+
+    if(workspace->levelsSize < (size_t)nodeCount) // tablica rang rosnie razem z grafem
+    {
+        workspace->levels.reset(new atomic<int32_t>[nodeCount]);
+        workspace->levelsSize = nodeCount;
+
+        for(int i = 0; i < nodeCount; ++i)
+            workspace->levels[i].store(INFINITE_RANK, memory_order_relaxed);
     }
 
+    while((int)threads.size() < threadCount)
+        threads.emplace_back(new TraversalThread());
+
+    atomic<int32_t> *distance = workspace->levels.get();
+
+    //Podzial frontu na paczki po PARALLEL_CHUNK wezlow - kazdy watek otrzymuje ciagly zakres paczek
+    auto assignChunks = [&]
+    {
+        uint64_t chunks = (frontier.size() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+
+        for(int t = 0; t < threadCount; ++t)
+            threads[t]->chunks.store((chunks * t / threadCount) << 32 | chunks * (t + 1) / threadCount, memory_order_relaxed);
+    };
+
+    distance[root].store(0, memory_order_relaxed);
+    frontier.assign(1, root);
+    assignChunks();
+
+    workspace->team.run(threadCount, [&](int id)
+    {
+        TraversalThread &mine = *threads[id];
+        vector<AuthorId> &next = mine.next;
+
+        if(mine.decoded.size() < compressedLists.getMaxDegree())
+            mine.decoded.resize(compressedLists.getMaxDegree());
+
+        while(!frontier.empty())
+        {
+            int nextRank = level + 1;
+
+            auto expand = [&](uint64_t chunk)
+            {
+                size_t end = min<size_t>((chunk + 1) * PARALLEL_CHUNK, frontier.size());
+
+                for(size_t f = chunk * PARALLEL_CHUNK; f < end; ++f)
+                    forEachCoAuthor(frontier[f], mine.decoded, [&](AuthorId i)
+                    {
+                        int expected = INFINITE_RANK;
+
+                        if(distance[i].load(memory_order_relaxed) == INFINITE_RANK &&
+                           distance[i].compare_exchange_strong(expected, nextRank, memory_order_relaxed))
+                            next.push_back(i);
+                    });
+            };
+
+            for(uint64_t chunk; takeFirstChunk(mine.chunks, chunk); ) // wlasne paczki
+                expand(chunk);
+
+            for(int victim = 1; victim < threadCount; ++victim) // kradziez paczek pozostalych watkow
+                for(uint64_t chunk; takeLastChunk(threads[(id + victim) % threadCount]->chunks, chunk); )
+                    expand(chunk);
+
+            barrier.wait(); // warstwa rozwinieta
+
+            if(id == 0) // przygotowanie scalonego frontu
+            {
+                size_t total = 0;
+                for(int t = 0; t < threadCount; ++t)
+                {
+                    threads[t]->offset = total;
+                    total += threads[t]->next.size();
+                }
+                stopped = !reportProgress(total, 0);
+                frontier.resize(stopped ? 0 : total);
+                assignChunks();
+                ++level;
+            }
+
+            barrier.wait();
+
+            if(!stopped)
+                copy(next.begin(), next.end(), frontier.begin() + mine.offset);
+            next.clear();
+
+            barrier.wait(); // front gotowy
+        }
+
+        //Przepisanie wyniku - rangi wracaja do stanu poczatkowego dla kolejnego zapytania
+        int slice = (nodeCount + threadCount - 1) / threadCount;
+
+        for(int i = id * slice; i < min(nodeCount, (id + 1) * slice); ++i)
+        {
+            result[i] = distance[i].load(memory_order_relaxed);
+            distance[i].store(INFINITE_RANK, memory_order_relaxed);
+        }
+    });
+
+    if(stopped)
+        return nullptr;
+
+    return makeResult(move(result));
+}
+
+AuthorsGraph::RankList *AuthorsGraph::getRanksDijkstry()
+{
+    vector<int> minDistance(nodeCount, INFINITE_RANK); // rangi/odlegosci wezlow od erdosa
+    set< pair<int,AuthorId> > activeVer; //zbior wezlow do rozpatrzenia
+    AuthorId root;
+    size_t popped = 0; // liczba wyjetych wezlow
+
+    freezeNeighborLists();
+
+    TraversalPool::Lease workspace = traversals.acquire(); // bufor odczytu list z puli (wezly zbioru alokowane sa jak dotad)
+    vector<AuthorId> &decoded = workspace->decoded;
 
-    activeVer.insert({0,"Erdos"}); //Dodaj Erdosa z oglegloscia 0
+    if(decoded.size() < compressedLists.getMaxDegree())
+        decoded.resize(compressedLists.getMaxDegree());
+
+    if(!findRoot(root))
+        return makeResult(move(minDistance));
+
+    minDistance[root] = 0;
+    activeVer.insert({0,root}); //Dodaj Erdosa z oglegloscia 0
 
     while (!activeVer.empty())
     {
 
         auto begin = activeVer.begin(); // wyjmij pierwszy wezel ze zbioru
-        string author = begin->second;
+        AuthorId author = begin->second;
+        int authorDist = begin->first;
         activeVer.erase( begin );
 
-        shared_ptr<Author> node = authorsMap[author];
+        if(++popped % PROGRESS_INTERVAL == 0 && !reportProgress(PROGRESS_INTERVAL, 0))
+            return nullptr;
 
-        for(auto coWorker :node->coWritersList) // dla kazdego wspolpracownika pobranego autora...
+        forEachCoAuthor(author, decoded, [&](AuthorId coWorker) // dla kazdego wspolpracownika pobranego autora...
         {
-            string coWorkName = coWorker->getName();
-            int authorDist = minDistance[author];
-            int coWorkDist = minDistance[coWorkName];
+            int coWorkDist = minDistance[coWorker];
 
             if( coWorkDist > authorDist + 1) // ...jesli jego teoretyczna odleglosc do Erdosa jest wieksza od odleglosci pobranego autora+1..
             {
-                activeVer.erase( {coWorkDist,coWorkName});
-                int dis = minDistance[coWorkName] = authorDist + 1; //...to ja zaktualizuj...
-                activeVer.insert( {dis, coWorkName} ); //..i dodaj do zbioru wezlow do rozpatrzenia
+                activeVer.erase( {coWorkDist,coWorker});
+                int dis = minDistance[coWorker] = authorDist + 1; //...to ja zaktualizuj...
+                activeVer.insert( {dis, coWorker} ); //..i dodaj do zbioru wezlow do rozpatrzenia
             }
-        }
+        });
     }
 
-    for(auto it: minDistance )// generowanie par nazwisko-ranga
+    reportProgress(popped % PROGRESS_INTERVAL, 0);
+    return makeResult(move(minDistance));
+}
+
+template<class Queue>
+AuthorsGraph::RankList *AuthorsGraph::getRanksDijkstry()
+{
+    vector<int> minDistance(nodeCount, INFINITE_RANK);
+    AuthorId root;
+    AuthorId author;
+    int authorDist;
+    size_t popped = 0;
+
+    freezeNeighborLists();
+
+    TraversalPool::Lease workspace = traversals.acquire(); // kolejka z puli zachowuje pamiec kubelkow/kopca
+    Queue &activeVer = get<Queue>(workspace->queues); // wezly do rozpatrzenia
+    vector<AuthorId> &decoded = workspace->decoded;
+
+    activeVer.clear(); // przerwane zadanie moglo pozostawic elementy
+    if(decoded.size() < compressedLists.getMaxDegree())
+        decoded.resize(compressedLists.getMaxDegree());
+
+    if(!findRoot(root))
+        return makeResult(move(minDistance));
+
+    minDistance[root] = 0;
+    activeVer.push(0, root);
+
+    while(!activeVer.empty())
     {
-        result->emplace_back(it.first, it.second);
+        activeVer.pop(authorDist, author);
+
+        if(authorDist > minDistance[author]) // nieaktualny wpis - autor zdjety juz z mniejsza odlegloscia
+            continue;
+
+        if(++popped % PROGRESS_INTERVAL == 0 && !reportProgress(PROGRESS_INTERVAL, 0))
+            return nullptr;
+
+        forEachCoAuthor(author, decoded, [&](AuthorId coWorker)
+        {
+            if(minDistance[coWorker] > authorDist + 1)
+            {
+                minDistance[coWorker] = authorDist + 1;
+                activeVer.push(authorDist + 1, coWorker);
+            }
+        });
     }
 
-    return result;
+    reportProgress(popped % PROGRESS_INTERVAL, 0);
+    return makeResult(move(minDistance));
+}
+
+template AuthorsGraph::RankList *AuthorsGraph::getRanksDijkstry<BucketQueue>();
+template AuthorsGraph::RankList *AuthorsGraph::getRanksDijkstry<RadixHeap>();
+template AuthorsGraph::RankList *AuthorsGraph::getRanksDijkstry<DAryHeap<4>>();
+template AuthorsGraph::RankList *AuthorsGraph::getRanksDijkstry<PairingHeap>();
+
+AuthorsGraph::RankList *AuthorsGraph::getRanks(const string &algorithm, int threadCount)
+{
+    if(algorithm == "bfs")
+        return getRanksBFS();
+    if(algorithm == "dijkstra")
+        return getRanksDijkstry();
+    if(algorithm == "dobfs")
+        return getRanksDirectionOptimizingBFS();
+    if(algorithm == "parallel")
+        return getRanksParallelBFS(threadCount);
+    if(algorithm == "dijkstra-bucket")
+        return getRanksDijkstry<BucketQueue>();
+    if(algorithm == "dijkstra-radix")
+        return getRanksDijkstry<RadixHeap>();
+    if(algorithm == "dijkstra-4ary")
+        return getRanksDijkstry<DAryHeap<4>>();
+    if(algorithm == "dijkstra-pairing")
+        return getRanksDijkstry<PairingHeap>();
+
+    return nullptr;
+}
+
+const vector<string> &AuthorsGraph::getAlgorithmNames()
+{
+    static const vector<string> algorithms = {"bfs", "dijkstra", "dobfs", "parallel",
+                                         "dijkstra-bucket", "dijkstra-radix", "dijkstra-4ary", "dijkstra-pairing"};
+    return algorithms;
 }
 
 void AuthorsGraph::presentGraph()
 {
+    if(hasPapers() || !compressedLists.empty()) // publikacje i listy skompresowane prezentowane sa jako CSR
+        freezeCoAuthors();
+
     cout<<"Liczba wezlow "<<nodeCount<<endl;
-    for (auto i: authorsMap)
-        i.second->presentAuthor();
+    for (int i = 0; i < nodeCount; ++i)
+    {
+        if(frozen)
+        {
+            cout<<"Autor: "<<getName(i)<<endl;
+            cout<<"Wspoltworzyl z: "<<endl;
+
+            for(uint32_t e = offsets[i]; e < offsets[i+1]; ++e)
+                cout<<"- "<< getName(neighbors[e]) <<endl;
+        }
+        else
+        {
+            cout<<"Autor: "<<names.get(i)<<endl;
+            cout<<"Wspoltworzyl z: "<<endl;
+
+            for(auto j: coWritersLists[i])
+                cout<<"- "<< names.get(j) <<endl;
+        }
+
+        cout<<endl;
+    }
 }
 
 void AuthorsGraph::clear()
 {
-    authorsMap.clear();
+    nodeCount = 0;
+    names.clear();
+    coWritersLists.clear();
+    pendingEdges.clear();
+    maintainedRanks.clear();
+    offsetsData.clear();
+    neighborsData.clear();
+    nameOrderData.clear();
+    snapshot.reset();
+    traversals.clear();
+    components.clear();
+    originalIdsData.clear();
+    compressedLists.clear();
+    frozen = false;
+    coAuthorLists = false;
+
+    paperOffsets.assign(bipartite ? 1 : 0, 0);
+    paperMembers.clear();
+    authorPaperOffsets.clear();
+    authorPapers.clear();
+
+    offsets = nullptr;
+    neighbors = nullptr;
+    edgeEntries = 0;
+    nameOffsets = nullptr;
+    nameOrder = nullptr;
+    nameChars = nullptr;
+    originalIds = nullptr;
+    originalIdsCount = 0;
 }
@@ -10,123 +10,337 @@
 #ifndef AUTHORSGRAPH_H
 #define AUTHORSGRAPH_H
 
+#include "stringarena.h"
+#include "jobprogress.h"
+#include "ranklist.h"
+#include "traversal.h"
+#include "components.h"
+#include "compressedadjacency.h"
 #include <iostream>
 #include <string>
-#include <memory>
-#include <map>
 #include <vector>
-#include <set>
+#include <memory>
+#include <unordered_map>
+#include <string_view>
+#include <cstdint>
 
 using namespace std;
 
+/**
+ * Typ wyliczeniowy okreslajacy kolejnosc wezlow nadawana przy zamrazaniu grafu (patrz AuthorsGraph::setVertexOrder)
+ */
+enum VertexOrder
+{
+    NATURAL_ORDER, /**< Kolejnosc dodawania autorow - bez przenumerowania */
+    DEGREE_ORDER, /**< Malejaca liczba wspolpracownikow - listy najczesciej odwiedzanych autorow lezace obok siebie */
+    BFS_ORDER, /**< Kolejnosc odwiedzin BFS od autora o najwiekszej liczbie wspolpracownikow (kazda skladowa od swojego centrum) */
+    RCM_ORDER /**< Odwrocona kolejnosc Cuthilla-McKee - wspolpracownicy otrzymuja bliskie identyfikatory (male pasmo macierzy) */
+};
+
+/**
+ * \brief Zwraca nazwe kolejnosci wezlow
+ * \param order Kolejnosc wezlow
+ * \return Zwraca nazwe uzywana w programach konsolowych (natural, degree, bfs, rcm)
+ */
+const char* vertexOrderName(VertexOrder order);
+
+/**
+ * \brief Wyszukuje kolejnosc wezlow po nazwie
+ * \param name Nazwa kolejnosci (patrz vertexOrderName)
+ * \param order Zmienna, do ktorej zostanie zapisana kolejnosc
+ * \return Zwraca true, jesli nazwa jest poprawna
+ */
+bool findVertexOrder(const string& name, VertexOrder& order);
+
 /**
  * \brief Klasa modelowa programu.
  *
  * Reprezentuje problem jako graf, w ktorym wezlami sa autorzy, a krawedz swiadczy
  * o napisaniu razem artykulu przez dana pare naukowcow. Udostepnia interfejs pozwalajacy wybrac sposob zaladowania danych
- * oraz algorytm uzyty do znalezienia rozwiazania
+ * oraz algorytm uzyty do znalezienia rozwiazania.
+ *
+ * Autorzy otrzymuja geste identyfikatory (0..n-1) nadawane przez arene internujaca nazwiska - kazde nazwisko
+ * przechowywane jest raz, w ciaglym buforze, a reszta programu posluguje sie identyfikatorami i widokami. Podczas ladowania krawedzie trafiaja do tymczasowych list
+ * wspolpracownikow, ktore po zakonczeniu ladowania sa "zamrazane" do postaci CSR (compressed sparse row):
+ * tablicy poczatkow list (offsets) oraz jednej tablicy sasiadow (neighbors). Bufor areny stanowi tablice napisow
+ * grafu, uzupelniana przy zamrazaniu o tablice identyfikatorow uporzadkowanych alfabetycznie.
+ * Algorytmy grafowe dzialaja wylacznie na postaci zamrozonej, odwolujac sie do niej przez wskazniki - dane moga
+ * nalezec do grafu albo pochodzic z odwzorowanego w pamieci pliku migawki (saveSnapshot / loadSnapshot).
+ *
+ * W trybie dwudzielnym (setBipartite) publikacje nie sa rozwijane w pary wspolautorow, lecz przechowywane jako
+ * hiperkrawedzie: listy autorow publikacji oraz, po zamrozeniu, listy publikacji autora (CSR grafu autor-publikacja).
+ * Pamiec i czas ladowania sa wtedy liniowe wzgledem liczby wpisow autorstwa, a BFS przechodzi przez publikacje.
+ *
+ * Opcjonalnie (setVertexOrder) zamrozenie przenumerowuje autorow tak, aby wspolpracownicy mieli bliskie identyfikatory,
+ * a ich odleglosci i listy lezaly w tych samych liniach pamieci podrecznej. Pierwotne identyfikatory sa zachowywane.
+ * Listy wspolpracownikow moga byc tez przechowywane w postaci skompresowanej (setCompressedAdjacency), odczytywanej
+ * przez BFS, algorytmy Dijkstry i findPath w trakcie przegladania.
  */
 class AuthorsGraph
 {
+public:
+    typedef uint32_t AuthorId; /**< Gesty identyfikator autora - indeks wezla w grafie */
+    typedef ::RankList RankList; /**< Lista rang autorow - tablica rang z nazwiskami odczytywanymi z tablicy napisow grafu */
 
     /**
-     * \brief Systemowa repezentacja Autora - wezla grafu.
-     *
-     * Przechowuje infomacje o autorze oraz zbior wskazan na
-     * osoby, z ktorymi wspoltworzyl
-     */
-    class Author
-    {
-    private:
-        int _number; /**< Numer Autora */
-        int _rank; /**< Liczba Erdosa Autora */
-        string _name; /**< Nazwisko Autora */
-        bool _isRanked; /**< Czy autorowi przydzielo liczbe Erdosa */
-        set<Author*> coWritersList; /**< Zbior wspolpracownikow danego Autora */
-
-    public:
-        friend class AuthorsGraph;
-
-        /** Konstruktor klasy autor */
-        Author(int n, string nam) :_number(n), _name(nam), _isRanked(false)
-        {}
-
-        /**
-         * \brief Dodaje wspolpracownika
-         * \param a Wspopracownik
-         */
-        void addEdge(Author* a)
-        {
-            coWritersList.insert(a);
-        }
+     * \brief Najkrotszy lancuch wspolpracy pomiedzy dwoma autorami (wynik findPath)
+     */
+    struct Path
+    {
+        int distance; /**< Liczba krawedzi lancucha (INFINITE_RANK, jesli autorzy nie sa polaczeni) */
+        vector<AuthorId> authors; /**< Kolejni autorzy lancucha, od autora poczatkowego do koncowego (puste, jesli brak) */
+        vector<uint32_t> publications; /**< Tryb dwudzielny: publikacja i (numer w kolejnosci ladowania) laczy autorow
+                                            authors[i] i authors[i+1]. Poza trybem dwudzielnym puste */
+        size_t visited; /**< Liczba autorow odwiedzonych przez wyszukiwanie (z obu stron) */
+    };
 
-        /**
-         * \brief Ustawia liczbe Erdosa
-         * \param n Liczba Erdosa
-         */
-        void setRank(int n)
-        {
-            _rank = n;
-            _isRanked = true;
-        }
+    static const int INFINITE_RANK; /**< Ranga autora nieosiagalnego z wezla Erdosa */
+    static const int DO_ALPHA; /**< BFS hybrydowy: przejdz na bottom-up, gdy krawedzie frontu > krawedzie nieodwiedzonych / DO_ALPHA */
+    static const int DO_BETA; /**< BFS hybrydowy: wroc na top-down, gdy wezly frontu < liczba wezlow / DO_BETA */
+    static const size_t PARALLEL_CHUNK; /**< BFS rownolegly: liczba wezlow frontu pobierana jednorazowo przez watek */
+    static const size_t MULTI_SOURCE_WIDTH; /**< BFS wielozrodlowy: najwieksza liczba zrodel przetwarzanych w jednym przebiegu */
+    static const size_t PROGRESS_INTERVAL; /**< Liczba autorow (lub publikacji) pomiedzy punktami kontrolnymi postepu zadania */
+
+    static const uint32_t SNAPSHOT_VERSION; /**< Wersja formatu pliku migawki */
+
+    /** Kontruktor klasy AuthorsGraph */
+    AuthorsGraph();
+
+    /** Dekontruktor klasy AuthorsGraph */
+    ~AuthorsGraph();
+
+    AuthorsGraph(const AuthorsGraph&) = delete; // widoki wskazuja na wlasne dane grafu
+    AuthorsGraph& operator=(const AuthorsGraph&) = delete;
 
-        /**
-         * \brief Zwraca liczbe Erdosa
-         * \return Zwraca liczbe Erdosa
-         */
-        int getRank() const
-        {
-            return _rank;
-        }
 
-        /**
-         * \brief Zwraca nazwisko autora
-         * \return Zwraca nazwisko autora
-         */
-        string getName() const
+private:
+    int nodeCount; /**< Liczba autorow */
+    string rootName; /**< Nazwisko autora, od ktorego liczone sa rangi (domyslnie Erdos) */
+    StringArena names; /**< Arena nazwisk - identyfikator nazwiska jest identyfikatorem autora */
+
+    vector<vector<AuthorId>> coWritersLists; /**< Tymczasowe listy wspolpracownikow, uzywane do momentu zamrozenia */
+    unordered_map<AuthorId, vector<AuthorId>> pendingEdges; /**< Krawedzie dodane do zamrozonego grafu, scalane z CSR przy nastepnym freeze() */
+    vector<int> maintainedRanks; /**< Rangi utrzymywane przyrostowo przez addPublications (puste, jesli nieaktualne) */
+
+    vector<uint32_t> offsetsData; /**< CSR: poczatki list wspolpracownikow (dane wlasne) */
+    vector<AuthorId> neighborsData; /**< CSR: skonkatenowane, posortowane listy wspolpracownikow (dane wlasne) */
+    vector<AuthorId> nameOrderData; /**< Identyfikatory autorow w kolejnosci alfabetycznej nazwisk */
+    shared_ptr<class MappedFile> snapshot; /**< Odwzorowany plik migawki, jesli graf z niego pochodzi */
+    TraversalPool traversals; /**< Pamieci robocze zapytan (findPath, BFS, BFS hybrydowy i wielowatkowy, Dijkstra), wielokrotnego uzytku */
+    ComponentIndex components; /**< Spojne skladowe, utrzymywane podczas dodawania krawedzi i zamrazane razem z grafem */
+    VertexOrder vertexOrder; /**< Kolejnosc wezlow nadawana przy zamrazaniu */
+    vector<AuthorId> originalIdsData; /**< Pierwotny identyfikator (kolejnosc dodania) autora przenumerowanego grafu
+                                           (puste, jesli graf nie byl przenumerowany) */
+    bool compressAdjacency; /**< Czy zamrazac listy wspolpracownikow do postaci skompresowanej */
+    CompressedAdjacency compressedLists; /**< Skompresowane listy wspolpracownikow (puste, jesli graf ich nie przechowuje) */
+
+    const uint32_t* offsets; /**< Widok CSR: lista wspolpracownikow autora i to neighbors[offsets[i]..offsets[i+1]) */
+    const AuthorId* neighbors; /**< Widok CSR: tablica wspolpracownikow */
+    size_t edgeEntries; /**< Dlugosc tablicy neighbors (dwukrotnosc liczby krawedzi) */
+    const uint32_t* nameOffsets; /**< Widok tablicy napisow: nazwisko i to nameChars[nameOffsets[i]..nameOffsets[i+1]) */
+    const AuthorId* nameOrder; /**< Widok tablicy napisow: identyfikatory w kolejnosci alfabetycznej */
+    const char* nameChars; /**< Widok tablicy napisow: znaki nazwisk */
+    const AuthorId* originalIds; /**< Widok: pierwotne identyfikatory autorow - tablica wlasna lub odwzorowana */
+    size_t originalIdsCount; /**< Liczba pierwotnych identyfikatorow (0, jesli graf nie byl przenumerowany) */
+    bool frozen; /**< Czy graf zostal zamrozony do postaci CSR */
+    bool coAuthorLists; /**< Czy widoki CSR list wspolpracownikow sa aktualne (w trybie dwudzielnym budowane na zadanie) */
+
+    bool bipartite; /**< Czy ladowane publikacje przechowywac jako hiperkrawedzie (tryb dwudzielny) */
+    vector<uint32_t> paperOffsets; /**< Tryb dwudzielny: autorzy publikacji p to paperMembers[paperOffsets[p]..paperOffsets[p+1]) */
+    vector<AuthorId> paperMembers; /**< Tryb dwudzielny: skonkatenowane, posortowane listy autorow publikacji */
+    vector<uint32_t> authorPaperOffsets; /**< Tryb dwudzielny: publikacje autora a to authorPapers[authorPaperOffsets[a]..authorPaperOffsets[a+1]) */
+    vector<uint32_t> authorPapers; /**< Tryb dwudzielny: skonkatenowane listy publikacji autorow (puste przed zamrozeniem) */
+    JobProgress* progress; /**< Postep zadania, ktorego czescia sa obliczenia (lub nullptr) */
+    int buildThreads; /**< Liczba watkow ladowania i zamrazania grafu */
+
+    /**
+     * \brief Ustawia widoki na dane wlasne grafu
+     */
+    void attachOwnedData();
+
+    /**
+     * \brief Kopiuje dane odwzorowanej migawki do danych wlasnych grafu, aby mozna go bylo modyfikowac
+     */
+    void detachSnapshot();
+
+    /**
+     * \brief Informuje czy graf przechowuje publikacje jako hiperkrawedzie
+     */
+    bool hasPapers() const
+    {
+        return !paperOffsets.empty();
+    }
+
+    /**
+     * \brief Zamraza graf i zapewnia listy wspolpracownikow czytane przez forEachCoAuthor: skompresowane, jesli graf
+     * je przechowuje, a w przeciwnym wypadku CSR (patrz freezeCoAuthors)
+     */
+    void freezeNeighborLists()
+    {
+        freeze();
+
+        if(compressedLists.empty())
+            freezeCoAuthors();
+    }
+
+    /**
+     * \brief Wywoluje visit dla kazdego wspolpracownika autora - z CSR lub, jesli graf przechowuje listy skompresowane,
+     * po ich odczytaniu do bufora. Wymaga freezeNeighborLists
+     * \param a Identyfikator autora
+     * \param decoded Bufor na co najmniej compressedLists.getMaxDegree() identyfikatorow
+     * \param visit Funkcja wywolywana dla wspolpracownika
+     */
+    template<class Visit>
+    void forEachCoAuthor(AuthorId a, vector<AuthorId>& decoded, const Visit& visit) const
+    {
+        if(compressedLists.empty())
         {
-            return _name;
+            for(uint32_t e = offsets[a]; e < offsets[a+1]; ++e)
+                visit(neighbors[e]);
+            return;
         }
 
-        /**
-         * \brief Informuje czy autorowi przydzielono juz liczbe Erdosa.
-         * Stosowane przez algorytm BFS
-         * \return Informuje czy autorowi przydzielono juz liczbe Erdosa
-         */
-        bool isRanked() const
+        uint32_t degree = compressedLists.decode(a, decoded.data());
+
+        for(uint32_t i = 0; i < degree; ++i)
+            visit(decoded[i]);
+    }
+
+    /**
+     * \brief Zwraca liste wspolpracownikow autora: wskaznik do CSR lub, jesli graf przechowuje listy skompresowane,
+     * do bufora, do ktorego lista zostala odczytana. Wymaga freezeNeighborLists
+     * \param a Identyfikator autora
+     * \param decoded Bufor na co najmniej compressedLists.getMaxDegree() identyfikatorow
+     * \param degree Zmienna, do ktorej zostanie zapisana liczba wspolpracownikow
+     */
+    const AuthorId* coAuthorList(AuthorId a, vector<AuthorId>& decoded, uint32_t& degree) const
+    {
+        if(compressedLists.empty())
         {
-            return _isRanked;
+            degree = offsets[a+1] - offsets[a];
+            return neighbors + offsets[a];
         }
 
-        /**
-         * \brief Prezentuje autora na wyjsciu standardowym
-         */
-        void presentAuthor()
-        {
-            cout<<"Autor: "<<_name<<endl;
-            cout<<"Wspoltworzyl z: "<<endl;
+        degree = compressedLists.decode(a, decoded.data());
+        return decoded.data();
+    }
 
-            for(auto i: coWritersList)
-                //cout<<"- "<< i.lock()->_name <<endl;
-                cout<<"- "<< i->_name <<endl;
+    /**
+     * \brief Zwraca liczbe wspolpracownikow autora - z CSR lub z naglowka listy skompresowanej. Wymaga freezeNeighborLists
+     * \param a Identyfikator autora
+     */
+    uint32_t coAuthorCount(AuthorId a) const
+    {
+        return compressedLists.empty() ? offsets[a+1] - offsets[a] : compressedLists.getDegree(a);
+    }
 
-            cout<<endl;
-        }
+    /**
+     * \brief Buduje listy publikacji autorow (sortowanie przez zliczanie) - zamrozenie w trybie dwudzielnym
+     */
+    void buildAuthorPapers();
 
-    };
-public:
-    /** Kontruktor klasy AuthorsGraph */
-    AuthorsGraph() : nodeCount(0)
-    {}
+    /**
+     * \brief BFS przechodzacy przez publikacje grafu dwudzielnego - kazda publikacja rozwijana jest raz,
+     * przy pierwszym odwiedzonym autorze
+     * \param distance Tablica odleglosci z odleglosciami zrodla (0), wypelniana przez przebieg
+     * \param queue Kolejka FIFO zawierajaca zrodlo
+     * \param side Pamiec robocza, ktorej znaczniki publikacji oznaczaja publikacje rozwiniete
+     * \return Zwraca false, jesli przerwano zadanie
+     */
+    bool bipartiteBFS(vector<int>& distance, vector<AuthorId>& queue, TraversalSide& side);
 
-    /** Dekontruktor klasy AuthorsGraph */
-    ~AuthorsGraph()
-    {}
+    /**
+     * \brief Liczba krawedzi dodawanych przez publikacje (do postepu zadania)
+     * \param authors Liczba autorow publikacji
+     * \return Zwraca liczbe par wspolautorow lub, w trybie dwudzielnym, liczbe wpisow autorstwa
+     */
+    uint64_t publicationEdges(size_t authors) const
+    {
+        return bipartite ? authors : authors * (authors - 1) / 2;
+    }
 
+    /**
+     * \brief Scala krawedzie i autorow dodanych do zamrozonego grafu z postacia CSR
+     */
+    void mergePending();
 
-private:
-    int nodeCount; /**< Liczba autorow */
-    map<string,shared_ptr<Author>> authorsMap; /**< Mapa par (nazwisko autora)- (wskaznik na wezel) */
+    /**
+     * \brief Rownolegle ladowanie publikacji do pustego grafu (graf wspolautorstwa, buildThreads > 1).
+     *
+     * Watki przetwarzaja ciagle bloki publikacji: internuja nazwiska w lokalnych arenach i zapisuja krawedzie
+     * skierowane jako pary identyfikatorow lokalnych. Areny blokow scalane sa nastepnie z arena grafu w kolejnosci
+     * publikacji (identyfikatory sa takie jak przy ladowaniu sekwencyjnym), pary tlumaczone na identyfikatory grafu,
+     * a buildCSR sortuje je i usuwa powtorzenia
+     * \param publications Lista publikacji
+     * \param createAuthors Czy tworzyc wezly dla nieznanych autorow (jak w addPublication)
+     */
+    void loadGraphParallel(const vector<vector<string>>& publications, bool createAuthors);
+
+    /**
+     * \brief Buduje CSR z krawedzi skierowanych zapisanych jako klucze (u << idBits) | v: rownolegle sortowanie
+     * pozycyjne, usuniecie powtorzen i wyznaczenie poczatkow list
+     * \param keys Klucze krawedzi (zwalniane po budowie)
+     * \param idBits Liczba bitow identyfikatora autora w kluczu
+     */
+    void buildCSR(vector<uint64_t>& keys, int idBits);
+
+    /**
+     * \brief Konczy zamrazanie: przenumerowuje wezly (patrz setVertexOrder), kompresuje listy wspolpracownikow
+     * (patrz setCompressedAdjacency), wyznacza porzadek alfabetyczny nazwisk i ustawia widoki na dane wlasne grafu
+     */
+    void finishFreeze();
+
+    /**
+     * \brief Wyznacza kolejnosc wezlow zamrozonego grafu wedlug vertexOrder
+     * \return Zwraca permutacje: nowy identyfikator -> dotychczasowy
+     */
+    vector<AuthorId> computeVertexOrder() const;
+
+    /**
+     * \brief Przenumerowuje wezly zamrozonego grafu: nazwiska, listy wspolpracownikow (lub autorow publikacji)
+     * i skladowe. Listy pozostaja posortowane
+     * \param order Permutacja: nowy identyfikator -> dotychczasowy
+     */
+    void relabel(vector<AuthorId>&& order);
+
+    /**
+     * \brief Zwraca identyfikator autora, od ktorego liczone sa rangi
+     * \param id Zmienna, do ktorej zostanie zapisany identyfikator
+     * \return Zwraca true, jesli autor wystepuje w grafie
+     */
+    bool findRoot(AuthorId& id) const
+    {
+        return findAuthor(rootName, id);
+    }
+
+    /**
+     * \brief Jeden przebieg BFS wielozrodlowego dla co najwyzej 64*W zrodel
+     * \param roots Zrodla przebiegu
+     * \param count Liczba zrodel
+     * \param distances Tablice odleglosci zrodel, wypelniane przez przebieg
+     * \param decoded Bufor odczytu list skompresowanych (patrz forEachCoAuthor)
+     * \return Zwraca false, jesli przerwano zadanie
+     */
+    template<int W>
+    bool multiSourceBFS(const AuthorId* roots, size_t count, vector<int>* distances, vector<AuthorId>& decoded) const;
+
+    /**
+     * \brief Tworzy liste rang przejmujac tablice odleglosci - ani odleglosci, ani nazwiska nie sa kopiowane
+     * \param distance Odleglosci indeksowane identyfikatorem autora
+     * \return Zwraca wskaznik na liste rang
+     */
+    RankList * makeResult(vector<int>&& distance) const;
+
+    /**
+     * \brief Punkt kontrolny zadania - dolicza wykonana prace do postepu
+     * \param visited Liczba autorow odwiedzonych od poprzedniego punktu
+     * \param edges Liczba krawedzi dodanych od poprzedniego punktu
+     * \return Zwraca false, jesli zazadano przerwania zadania
+     */
+    bool reportProgress(uint64_t visited, uint64_t edges) const
+    {
+        return !progress || progress->report(visited, edges);
+    }
 
 public:
 
@@ -144,16 +358,412 @@ public:
     void loadGraph(std::vector<std::vector<string>>& publications);
 
     /**
-     * \brief Oblicza liczby Erdosa uzywajac algorytmu Dijkstry
-     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa
+     * \brief Dodaje autora do budowanego grafu, o ile jeszcze w nim nie istnieje.
+     * Pozwala ladowac graf przyrostowo (np. strumieniowo z pliku XML), bez posredniej listy autorow
+     * \param name Nazwisko autora
+     * \return Zwraca identyfikator autora
+     */
+    AuthorId addAuthor(string_view name);
+
+    /**
+     * \brief Dodaje krawedzie pomiedzy wszystkimi parami wspolautorow publikacji.
+     * W trybie dwudzielnym zapisuje publikacje jako jedna hiperkrawedz (autorzy bez powtorzen)
+     * \param coAuthors Identyfikatory wspolautorow
+     */
+    void addPublication(const vector<AuthorId>& coAuthors);
+
+    /**
+     * \brief Dodaje publikacje do budowanego grafu
+     * \param coAuthors Nazwiska wspolautorow
+     * \param createAuthors Czy tworzyc wezly dla nieznanych autorow (ladowanie po publikacjach). W przeciwnym
+     * wypadku autorzy nieobecni w grafie sa pomijani (pelne ladowanie)
+     */
+    void addPublication(const vector<string>& coAuthors, bool createAuthors);
+
+    /**
+     * \brief Zamraza graf do postaci CSR. Wywolywane automatycznie przez loadGraph
+     */
+    void freeze();
+
+    /**
+     * \brief Zamraza graf i zapewnia aktualne listy wspolpracownikow - w trybie dwudzielnym rozwija publikacje
+     * w pary wspolautorow (przy pierwszym wywolaniu). Wywolywana przez algorytmy, ktore nie przechodza przez publikacje
+     */
+    void freezeCoAuthors();
+
+    /**
+     * \brief Zwraca liczbe wspolpracownikow autora. Wymaga aktualnych list wspolpracownikow (patrz freezeCoAuthors)
+     * \param id Identyfikator autora
+     */
+    uint32_t getDegree(AuthorId id) const
+    {
+        return offsets[id+1] - offsets[id];
+    }
+
+    /**
+     * \brief Zwraca rosnaco posortowana liste wspolpracownikow autora (getDegree elementow).
+     * Wymaga aktualnych list wspolpracownikow (patrz freezeCoAuthors)
+     * \param id Identyfikator autora
+     * \return Zwraca wskaznik na pierwszego wspolpracownika, wazny do kolejnej modyfikacji grafu
+     */
+    const AuthorId* getCoAuthors(AuthorId id) const
+    {
+        return neighbors + offsets[id];
+    }
+
+    /**
+     * \brief Wybiera sposob przechowywania publikacji dla kolejnych ladowan i usuwa zawartosc grafu.
+     *
+     * W trybie dwudzielnym publikacja o k autorach zajmuje k wpisow zamiast k(k-1) wpisow list wspolpracownikow,
+     * a getRanksBFS / getDistancesBFS przechodza przez publikacje. Pozostale algorytmy, zapis migawki i addPublications
+     * wymagaja list wspolpracownikow - sa one rozwijane z publikacji przy pierwszym uzyciu. Rangi sa w obu trybach identyczne
+     * \param enabled Czy przechowywac publikacje jako hiperkrawedzie (domyslnie false)
+     */
+    void setBipartite(bool enabled)
+    {
+        bipartite = enabled;
+        clear();
+    }
+
+    /**
+     * \brief Informuje czy publikacje przechowywane sa jako hiperkrawedzie
+     */
+    bool isBipartite() const
+    {
+        return bipartite;
+    }
+
+    /**
+     * \brief Zwraca liczbe publikacji grafu dwudzielnego
+     * \return Zwraca liczbe zaladowanych publikacji - numery publikacji to ich kolejnosc ladowania (0 poza trybem dwudzielnym)
+     */
+    size_t getPublicationsCount() const
+    {
+        return hasPapers() ? paperOffsets.size() - 1 : 0;
+    }
+
+    /**
+     * \brief Informuje czy graf zostal zamrozony
+     * \return Zwraca true, jesli graf jest w postaci CSR
+     */
+    bool isFrozen() const
+    {
+        return frozen;
+    }
+
+    /**
+     * \brief Zwraca liczbe autorow
+     * \return Zwraca liczbe wezlow grafu
+     */
+    int getAuthorsCount() const
+    {
+        return nodeCount;
+    }
+
+    /**
+     * \brief Zwraca liczbe krawedzi zamrozonego grafu. W trybie dwudzielnym - liczbe krawedzi grafu
+     * autor-publikacja (wpisow autorstwa), bez rozwijania list wspolpracownikow
+     * \return Zwraca liczbe nieskierowanych krawedzi
+     */
+    size_t getEdgesCount() const
+    {
+        if(hasPapers())
+            return paperMembers.size();
+
+        return (compressedLists.empty() ? edgeEntries : compressedLists.getEntries()) / 2;
+    }
+
+    /**
+     * \brief Zwraca rozmiar struktur sasiedztwa grafu w pamieci: CSR list wspolpracownikow, list skompresowanych
+     * i list grafu dwudzielnego (bez nazwisk)
+     * \return Zwraca liczbe bajtow
+     */
+    size_t getAdjacencyBytes() const;
+
+    /**
+     * \brief Zwraca nazwisko autora zamrozonego grafu
+     * \param id Identyfikator autora
+     * \return Zwraca widok na nazwisko przechowywane w tablicy napisow, wazny do wyczyszczenia grafu
+     */
+    string_view getName(AuthorId id) const
+    {
+        return string_view(nameChars + nameOffsets[id], nameOffsets[id+1] - nameOffsets[id]);
+    }
+
+    /**
+     * \brief Zwraca spojne skladowe grafu (zamraza graf). Pozwala w stalym czasie sprawdzic, czy autorzy sa polaczeni
+     * lancuchem wspolpracy, oraz ocenic graf: liczba skladowych, udzial najwiekszej, autorzy bez wspolpracownikow
+     * \return Zwraca indeks skladowych, wazny do kolejnej modyfikacji lub wyczyszczenia grafu
+     */
+    const ComponentIndex& getComponents()
+    {
+        freeze();
+        return components;
+    }
+
+    /**
+     * \brief Zwraca autora zamrozonego grafu o danej pozycji w kolejnosci alfabetycznej nazwisk
+     * \param position Pozycja (0..getAuthorsCount()-1)
+     */
+    AuthorId getAlphabetical(int position) const
+    {
+        return nameOrder[position];
+    }
+
+    /**
+     * \brief Wyszukuje autora po nazwisku
+     * \param name Nazwisko autora
+     * \param id Zmienna, do ktorej zostanie zapisany identyfikator
+     * \return Zwraca true, jesli autor wystepuje w grafie
+     */
+    bool findAuthor(string_view name, AuthorId& id) const;
+
+    /**
+     * \brief Ustawia autora, od ktorego liczone sa rangi we wszystkich algorytmach getRanks*
+     * \param name Nazwisko autora (domyslnie Erdos). Jesli autora nie ma w grafie, wszystkie rangi sa nieskonczone
+     */
+    void setRoot(string_view name)
+    {
+        rootName = name;
+        maintainedRanks.clear();
+    }
+
+    /**
+     * \brief Przypina graf do zadania: ladowanie i algorytmy getRanks* / getDistances* zglaszaja postep
+     * (odwiedzonych autorow i dodane krawedzie) co PROGRESS_INTERVAL jednostek pracy i w tych punktach sprawdzaja
+     * zadanie przerwania. Przerwany algorytm zwraca nullptr, a przerwane ladowanie pozostawia graf pusty
+     * \param jobProgress Postep zadania lub nullptr (domyslnie)
+     */
+    void setProgress(JobProgress* jobProgress)
+    {
+        progress = jobProgress;
+    }
+
+    /**
+     * \brief Ustawia liczbe watkow ladowania i zamrazania grafu. Przy wiecej niz jednym watku loadGraph
+     * (poza trybem dwudzielnym) buduje CSR rownolegle, przez sortowanie par wspolautorow, a freeze() sortuje
+     * listy wspolpracownikow i nazwiska na wielu watkach. Wynikowy graf nie zalezy od liczby watkow
+     * \param threads Liczba watkow (wartosci mniejsze od 1 traktowane sa jak 1, domyslnie 1)
+     */
+    void setBuildThreads(int threads)
+    {
+        buildThreads = threads < 1 ? 1 : threads;
+    }
+
+    /**
+     * \brief Ustawia kolejnosc wezlow nadawana przy kolejnych zamrozeniach zaladowanego grafu (loadGraph, freeze).
+     *
+     * Kolejnosc inna niz NATURAL_ORDER przenumerowuje autorow po zbudowaniu CSR - BFS i Dijkstra odwiedzaja wtedy
+     * sasiednie komorki tablic odleglosci i list zamiast losowych. Nazwiska i wyniki odnosza sie do nowych
+     * identyfikatorow, a getOriginalId zwraca identyfikator nadany przy dodaniu autora. Krawedzie dodane przez
+     * addPublications, migawki i scalanie zmian nie zmieniaja numeracji
+     * \param order Kolejnosc wezlow (domyslnie NATURAL_ORDER)
+     */
+    void setVertexOrder(VertexOrder order)
+    {
+        vertexOrder = order;
+    }
+
+    /**
+     * \brief Wybiera postac list wspolpracownikow nadawana przy kolejnych zamrozeniach zaladowanego grafu.
+     *
+     * W postaci skompresowanej (CompressedAdjacency) CSR jest po zamrozeniu zastepowany listami kodowanymi roznicowo,
+     * zwykle kilkukrotnie mniejszymi, a wszystkie algorytmy wyznaczania rang i odleglosci oraz findPath odczytuja
+     * listy w trakcie przegladania. Jedynie zapis migawki i indeks odleglosci rozwijaja przy pierwszym uzyciu pelny CSR
+     * (freezeCoAuthors), a addPublications wraca do CSR na stale. W trybie dwudzielnym opcja nie ma znaczenia
+     * \param enabled Czy kompresowac listy (domyslnie false)
+     */
+    void setCompressedAdjacency(bool enabled)
+    {
+        compressAdjacency = enabled;
+    }
+
+    /**
+     * \brief Informuje czy graf przechowuje listy wspolpracownikow w postaci skompresowanej
      */
-    vector<pair<string, int> > * getRanksBFS();
+    bool isCompressed() const
+    {
+        return !compressedLists.empty();
+    }
+
+    /**
+     * \brief Zwraca kolejnosc wezlow nadawana przy zamrazaniu
+     */
+    VertexOrder getVertexOrder() const
+    {
+        return vertexOrder;
+    }
+
+    /**
+     * \brief Zwraca identyfikator nadany autorowi przy dodaniu (przed przenumerowaniem wezlow)
+     * \param id Identyfikator autora zamrozonego grafu
+     * \return Zwraca pierwotny identyfikator (id, jesli graf nie byl przenumerowany)
+     */
+    AuthorId getOriginalId(AuthorId id) const
+    {
+        return id < originalIdsCount ? originalIds[id] : id;
+    }
+
+    /**
+     * \brief Zwraca postep zadania, do ktorego przypiety jest graf
+     * \return Zwraca wskaznik na postep lub nullptr
+     */
+    JobProgress* getProgress() const
+    {
+        return progress;
+    }
+
+    /**
+     * \brief Zwraca nazwisko autora, od ktorego liczone sa rangi
+     * \return Zwraca nazwisko autora zrodlowego
+     */
+    const string& getRoot() const
+    {
+        return rootName;
+    }
+
+    /**
+     * \brief Zapisuje zamrozony graf do binarnego pliku migawki.
+     *
+     * Plik sklada sie z naglowka (sygnatura, wersja, rozmiary i polozenie sekcji, podsumowanie skladowych), sekcji
+     * CSR (offsets, neighbors), tablicy napisow (poczatki nazwisk, porzadek alfabetyczny, znaki) oraz tablic spojnych
+     * skladowych (numer skladowej autora, rozmiary skladowych) i permutacji przenumerowania wezlow (pierwotne
+     * identyfikatory - sekcja pusta dla kolejnosci naturalnej). Sekcje sa wyrownane do 8 bajtow
+     * \param path Sciezka do pliku
+     * \return Zwraca true, jesli operacja sie powiodla
+     */
+    bool saveSnapshot(const string& path);
+
+    /**
+     * \brief Laduje graf z pliku migawki bez deserializacji.
+     *
+     * Plik jest odwzorowywany w pamieci, a algorytmy czytaja sekcje CSR, tablice napisow, tablice skladowych
+     * i pierwotne identyfikatory (getOriginalId) bezposrednio z odwzorowanych stron. Poprzednia zawartosc grafu jest usuwana
+     * \param path Sciezka do pliku
+     * \return Zwraca true, jesli plik jest poprawna migawka w obslugiwanej wersji
+     */
+    bool loadSnapshot(const string& path);
 
     /**
      * \brief Oblicza liczby Erdosa uzywajac algorytmu BFS
-     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa
+     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa (nullptr, jesli przerwano zadanie - patrz setProgress)
+     */
+    RankList * getRanksBFS();
+
+    /**
+     * \brief Oblicza odleglosci wszystkich autorow od wskazanego autora algorytmem BFS
+     * \param root Identyfikator autora zrodlowego
+     * \return Zwraca wskaznik na tablice odleglosci indeksowana identyfikatorem autora (nullptr, jesli przerwano zadanie)
+     */
+    vector<int> * getDistancesBFS(AuthorId root);
+
+    /**
+     * \brief Oblicza odleglosci od wielu autorow jednoczesnie, bitowo-rownoleglym BFS wielozrodlowym (MS-BFS).
+     *
+     * Kazdy autor przechowuje maski 64, 128 lub 256 bitow (bit i - zrodlo i): zbior zrodel, ktore go juz osiagnely,
+     * oraz zrodel, ktorych front zawiera go w biezacej warstwie. Rozwiniecie warstwy sumuje maski wspolpracownikow
+     * operacjami na slowach, wiec graf przegladany jest raz na warstwe dla wszystkich zrodel naraz. Szerokosc maski
+     * dobierana jest do liczby zrodel, a wiecej niz MULTI_SOURCE_WIDTH zrodel przetwarzanych jest w kolejnych przebiegach
+     * \param roots Identyfikatory autorow zrodlowych
+     * \return Zwraca wskaznik na tablice odleglosci: (*result)[i][v] to odleglosc autora v od roots[i] (nullptr, jesli przerwano zadanie)
+     */
+    vector<vector<int>> * getDistancesMultiSourceBFS(const vector<AuthorId>& roots);
+
+    /**
+     * \brief Wyznacza odleglosc i jeden najkrotszy lancuch wspolpracy pomiedzy dwoma autorami dwukierunkowym BFS.
+     *
+     * Przeszukiwanie prowadzone jest jednoczesnie od obu autorow - w kazdym kroku rozwijana jest cala warstwa
+     * mniejszego frontu - i konczy sie po warstwie, w ktorej fronty sie spotkaly. Autorzy roznych skladowych
+     * (patrz getComponents) sa rozpoznawani bez przeszukiwania. Zapytanie pobiera z puli pamiec
+     * robocza (tablice odleglosci i rodzicow oraz znaczniki odwiedzin opatrzone numerem przebiegu), ktorej nie trzeba
+     * zerowac, wiec koszt zapytania zalezy od odwiedzonej czesci grafu, a nie od jego rozmiaru, a kolejne zapytania
+     * nie alokuja pamieci. Na zamrozonym grafie bez oczekujacych krawedzi zapytania moga byc zadawane z wielu watkow.
+     * W trybie dwudzielnym wyszukiwanie przechodzi przez publikacje i zwraca publikacje kolejnych krokow lancucha
+     * \param from Nazwisko autora poczatkowego
+     * \param to Nazwisko autora koncowego
+     * \param path Zmienna, do ktorej zostanie zapisany wynik
+     * \return Zwraca false, jesli ktoregos z autorow nie ma w grafie
+     */
+    bool findPath(string_view from, string_view to, Path& path);
+
+    /**
+     * \brief Wyznacza odleglosc i jeden najkrotszy lancuch wspolpracy pomiedzy dwoma autorami dwukierunkowym BFS
+     * \param from Identyfikator autora poczatkowego
+     * \param to Identyfikator autora koncowego
+     * \param path Zmienna, do ktorej zostanie zapisany wynik
+     */
+    void findPath(AuthorId from, AuthorId to, Path& path);
+
+    /**
+     * \brief Dodaje publikacje do zamrozonego grafu i przyrostowo naprawia rangi.
+     *
+     * Nowi autorzy otrzymuja kolejne identyfikatory, a nowe krawedzie trafiaja do list oczekujacych, wiec wstawienie
+     * nie przebudowuje CSR (scala je dopiero nastepne wywolanie freeze(), np. przez getRanks*). Rangi liczone od
+     * autora zrodlowego sa utrzymywane pomiedzy wywolaniami: przy pierwszym wywolaniu (lub po zmianie zrodla) sa
+     * wyznaczane pelnym BFS, a pozniej nowa krawedz moze jedynie zmniejszyc rangi - zmniejszenie propagowane jest
+     * kolejka kubelkowa wylacznie od koncow krawedzi, ktorych ranga sie poprawila.
+     * Widoki na nazwiska zwrocone wczesniej przez graf traca waznosc
+     * \param publications Lista publikacji (nazwiska wspolautorow)
+     * \return Zwraca wskaznik na liste autorow, ktorych ranga sie zmienila, wraz z nowa ranga (w kolejnosci alfabetycznej)
+     * (nullptr, jesli przerwano zadanie podczas wyznaczania rang poczatkowych - publikacje nie zostaja wtedy dodane)
+     */
+    RankList * addPublications(const vector<vector<string>>& publications);
+
+    /**
+     * \brief Oblicza liczby Erdosa uzywajac BFS optymalizujacego kierunek przeszukiwania (top-down / bottom-up).
+     *
+     * Dopoki front jest maly, kolejne warstwy wyznaczane sa klasycznie (top-down). Gdy front obejmuje znaczna czesc
+     * krawedzi grafu, algorytm przechodzi na tryb bottom-up: kazdy nieodwiedzony autor szuka wsrod swoich
+     * wspolpracownikow kogos z biezacego frontu i konczy przeglad po pierwszym trafieniu
+     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa (nullptr, jesli przerwano zadanie - patrz setProgress)
+     */
+    RankList * getRanksDirectionOptimizingBFS();
+
+    /**
+     * \brief Oblicza liczby Erdosa uzywajac wielowatkowego BFS synchronizowanego warstwami.
+     *
+     * Biezacy front dzielony jest na paczki po PARALLEL_CHUNK wezlow, a kazdy watek otrzymuje ciagly zakres paczek
+     * (wlasna kolejke). Watek pobiera paczki z poczatku swojego zakresu, a po jego wyczerpaniu kradnie je z konca
+     * zakresow pozostalych watkow. Nieodwiedzeni wspolpracownicy zajmowani sa atomowa operacja compare-exchange
+     * i zapisywani do lokalnych frontow, scalanych po zakonczeniu warstwy. Watki, tablica rang i fronty pochodza
+     * z pamieci roboczej puli, wiec kolejne zapytania nie uruchamiaja watkow ani nie alokuja pamieci poza wynikiem.
+     * Wynik jest identyczny z getRanksBFS
+     * \param threadCount Liczba watkow (wartosci mniejsze od 1 traktowane sa jak 1)
+     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa (nullptr, jesli przerwano zadanie - patrz setProgress)
+     */
+    RankList * getRanksParallelBFS(int threadCount);
+
+    /**
+     * \brief Oblicza liczby Erdosa uzywajac algorytmu Dijkstry
+     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa (nullptr, jesli przerwano zadanie - patrz setProgress)
+     */
+    RankList * getRanksDijkstry();
+
+    /**
+     * \brief Oblicza liczby Erdosa algorytmem Dijkstry z wybrana kolejka priorytetowa.
+     *
+     * Odleglosci przechowywane sa w tablicy indeksowanej identyfikatorem autora, a kolejka przechowuje
+     * pary (odleglosc, identyfikator). Dostepne polityki kolejki (priorityqueues.h): BucketQueue, RadixHeap,
+     * DAryHeap<4>, PairingHeap
+     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa (nullptr, jesli przerwano zadanie - patrz setProgress)
+     */
+    template<class Queue>
+    RankList * getRanksDijkstry();
+
+    /**
+     * \brief Oblicza liczby Erdosa algorytmem wskazanym nazwa
+     * \param algorithm Nazwa algorytmu (patrz getAlgorithmNames)
+     * \param threadCount Liczba watkow BFS rownoleglego
+     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa lub nullptr dla nieznanej nazwy i przerwanego zadania
+     */
+    RankList * getRanks(const string& algorithm, int threadCount = 1);
+
+    /**
+     * \brief Zwraca nazwy algorytmow akceptowane przez getRanks: bfs, dijkstra, dobfs, parallel
+     * oraz warianty Dijkstry z kolejkami: dijkstra-bucket, dijkstra-radix, dijkstra-4ary, dijkstra-pairing
+     * \return Zwraca liste nazw
      */
-    vector<pair<string, int> > * getRanksDijkstry();
+    static const vector<string>& getAlgorithmNames();
 
     /**
      * \brief Prezentuje graf na wyjsciu stardardowym
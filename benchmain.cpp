@@ -0,0 +1,337 @@
+/**
+ * \file   benchmain.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Start programu pomiarowego - serie pomiarow ladowania i algorytmow z wynikiem w formacie CSV lub JSON
+ */
+
+#include "authorsgraph.h"
+#include "benchmark.h"
+#include "generator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+
+namespace
+{
+/**
+ * \brief Parametry wywolania
+ */
+struct Options
+{
+    int startCount = 1000; /**< Najmniejsza liczba autorow */
+    int step = 1000; /**< Przyrost liczby autorow */
+    int stepNo = 5; /**< Liczba rozmiarow */
+    int warmups = 1; /**< Liczba przebiegow rozgrzewajacych */
+    int repetitions = 10; /**< Liczba mierzonych powtorzen */
+    int threads = 1; /**< Liczba watkow BFS rownoleglego, generatora i budowy grafu */
+    unsigned seed = 1; /**< Ziarno generatora danych */
+    GraphModel model = PREFERENTIAL_ATTACHMENT; /**< Model generowanego grafu */
+    int degree = 8; /**< Parametr gestosci generatora (patrz GeneratorParams::degree) */
+    string snapshot; /**< Plik migawki - jesli podany, graf jest jedynie generowany i zapisywany */
+    bool publicationsOnly = false; /**< Sposob ladowania grafu */
+    bool bipartite = false; /**< Czy przechowywac publikacje jako hiperkrawedzie (patrz AuthorsGraph::setBipartite) */
+    int indexQueries = 0; /**< Liczba par autorow faz index i query (0 - fazy pomijane) */
+    vector<VertexOrder> orders; /**< Kolejnosci wezlow fazy order (puste - faza pomijana) */
+    bool compressed = false; /**< Czy mierzyc faze compressed */
+    bool json = false; /**< Format wyniku */
+    vector<string> algorithms = {"bfs", "dijkstra", "dobfs", "parallel"}; /**< Mierzone algorytmy */
+    string output; /**< Plik wynikowy (pusty - wyjscie standardowe) */
+    bool help = false; /**< Czy wyswietlic opis wywolania */
+};
+
+/**
+ * \brief Wypisuje opis wywolania
+ * \param out Strumien wyjsciowy
+ */
+void printUsage(FILE* out)
+{
+    fputs("Użycie: erdos-bench [opcje]\n"
+          "Mierzy osobno ładowanie grafu i wyznaczanie rang dla losowych danych o rosnącym rozmiarze.\n"
+          "\n"
+          "  -n, --start N            najmniejsza liczba autorów (domyślnie 1000)\n"
+          "  -s, --step N             przyrost liczby autorów (domyślnie 1000)\n"
+          "  -c, --count N            liczba rozmiarów (domyślnie 5)\n"
+          "  -w, --warmup N           przebiegi rozgrzewające (domyślnie 1)\n"
+          "  -r, --repetitions N      mierzone powtórzenia (domyślnie 10)\n"
+          "  -a, --algorithms A,B,... mierzone algorytmy (domyślnie bfs,dijkstra,dobfs,parallel)\n"
+          "  -l, --loading full|publications  sposób ładowania modelu quadratic (domyślnie full)\n"
+          "      --storage clique|bipartite  reprezentacja publikacji (domyślnie clique): pary współautorów lub graf\n"
+          "                           dwudzielny autor–publikacja\n"
+          "  -t, --threads N          liczba wątków BFS równoległego, generatora i budowy grafu (domyślnie liczba rdzeni)\n"
+          "  -m, --model NAZWA        model danych (domyślnie ba): quadratic (ok. n²/4 krawędzi), ba (preferencyjne\n"
+          "                           dołączanie), rmat, teams (publikacje wieloautorskie)\n"
+          "  -d, --degree N           krawędzie na autora (ba, rmat) lub publikacje na autora (teams), domyślnie 8\n"
+          "      --seed N             ziarno generatora danych (domyślnie 1)\n"
+          "      --index N            mierzy budowę indeksu odległości (pruned landmark labeling) i zapytania o odległość\n"
+          "                           N losowych par autorów: z indeksu oraz dwukierunkowym BFS (domyślnie 0 - bez pomiaru)\n"
+          "      --order K,L,...      mierzy algorytmy na grafie przenumerowanym kolejno: natural (kolejność dodania),\n"
+          "                           degree (malejąca liczba współpracowników), bfs (BFS od autora o największej liczbie\n"
+          "                           współpracowników), rcm (odwrócona kolejność Cuthilla-McKee); w systemie Linux\n"
+          "                           zlicza także chybienia pamięci podręcznej ostatniego poziomu (domyślnie bez pomiaru)\n"
+          "      --compressed on|off  mierzy bfs i algorytmy Dijkstry także na skompresowanych listach współpracowników\n"
+          "                           (kodowanie różnicowe, group varint); kolumna bytes podaje rozmiar list (domyślnie off)\n"
+          "      --snapshot PLIK      zamiast pomiarów zapisuje graf o N autorach (opcja -n) do pliku migawki\n"
+          "  -f, --format csv|json    format wyniku (domyślnie csv)\n"
+          "  -o, --output PLIK        plik wynikowy (domyślnie wyjście standardowe)\n"
+          "  -h, --help               wyświetla ten opis\n", out);
+}
+
+/**
+ * \brief Odczytuje liczbe calkowita
+ * \param value Napis
+ * \param minimum Najmniejsza dopuszczalna wartosc
+ * \param result Zmienna, do ktorej zostanie zapisana liczba
+ * \return Zwraca true, jesli napis jest liczba nie mniejsza od minimum
+ */
+bool parseInt(const string& value, int minimum, int& result)
+{
+    char* end;
+    long parsed = strtol(value.c_str(), &end, 10);
+
+    if(value.empty() || *end != '\0' || parsed < minimum || parsed > 100000000)
+        return false;
+
+    result = parsed;
+    return true;
+}
+
+/**
+ * \brief Odczytuje parametry wywolania
+ * \param argc Liczba argumentow
+ * \param argv Argumenty
+ * \param options Zmienna, do ktorej zostana zapisane parametry
+ * \return Zwraca true, jesli argumenty sa poprawne
+ */
+bool parseArguments(int argc, char* argv[], Options& options)
+{
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for(int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        int seed;
+
+        if(arg == "-h" || arg == "--help")
+        {
+            options.help = true;
+            return true;
+        }
+
+        if(i + 1 == argc) // kazda opcja poza --help wymaga wartosci
+        {
+            fprintf(stderr, "Brak wartości opcji %s\n", arg.c_str());
+            return false;
+        }
+
+        string value = argv[++i];
+        bool ok = true;
+
+        if(arg == "-n" || arg == "--start")
+            ok = parseInt(value, 10, options.startCount);
+        else if(arg == "-s" || arg == "--step")
+            ok = parseInt(value, 0, options.step);
+        else if(arg == "-c" || arg == "--count")
+            ok = parseInt(value, 1, options.stepNo);
+        else if(arg == "-w" || arg == "--warmup")
+            ok = parseInt(value, 0, options.warmups);
+        else if(arg == "-r" || arg == "--repetitions")
+            ok = parseInt(value, 1, options.repetitions);
+        else if(arg == "-t" || arg == "--threads")
+            ok = parseInt(value, 1, options.threads);
+        else if(arg == "-d" || arg == "--degree")
+            ok = parseInt(value, 1, options.degree);
+        else if(arg == "-m" || arg == "--model")
+            ok = findModel(value, options.model);
+        else if(arg == "--index")
+            ok = parseInt(value, 0, options.indexQueries);
+        else if(arg == "--snapshot")
+            options.snapshot = value;
+        else if(arg == "--seed")
+        {
+            ok = parseInt(value, 0, seed);
+            options.seed = seed;
+        }
+        else if(arg == "-a" || arg == "--algorithms")
+        {
+            auto& names = AuthorsGraph::getAlgorithmNames();
+            stringstream list(value);
+            string name;
+
+            options.algorithms.clear();
+            while(getline(list, name, ','))
+            {
+                if(find(names.begin(), names.end(), name) == names.end())
+                {
+                    fprintf(stderr, "Nieznany algorytm: %s\n", name.c_str());
+                    return false;
+                }
+                options.algorithms.push_back(name);
+            }
+            ok = !options.algorithms.empty();
+        }
+        else if(arg == "--order")
+        {
+            stringstream list(value);
+            string name;
+            VertexOrder order;
+
+            options.orders.clear();
+            while(getline(list, name, ','))
+            {
+                if(!findVertexOrder(name, order))
+                {
+                    fprintf(stderr, "Nieznana kolejność węzłów: %s\n", name.c_str());
+                    return false;
+                }
+                options.orders.push_back(order);
+            }
+            ok = !options.orders.empty();
+        }
+        else if(arg == "--compressed")
+        {
+            ok = value == "on" || value == "off";
+            options.compressed = value == "on";
+        }
+        else if(arg == "-l" || arg == "--loading")
+        {
+            ok = value == "full" || value == "publications";
+            options.publicationsOnly = value == "publications";
+        }
+        else if(arg == "--storage")
+        {
+            ok = value == "clique" || value == "bipartite";
+            options.bipartite = value == "bipartite";
+        }
+        else if(arg == "-f" || arg == "--format")
+        {
+            ok = value == "csv" || value == "json";
+            options.json = value == "json";
+        }
+        else if(arg == "-o" || arg == "--output")
+            options.output = value;
+        else
+        {
+            fprintf(stderr, "Nieznana opcja: %s\n", arg.c_str());
+            return false;
+        }
+
+        if(!ok)
+        {
+            fprintf(stderr, "Niepoprawna wartość opcji %s: %s\n", arg.c_str(), value.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Generuje graf, zamraza go i zapisuje do pliku migawki
+ * \param generator Parametry generatora
+ * \param path Sciezka do pliku
+ * \return Zwraca true, jesli zapis sie powiodl
+ */
+bool writeSnapshot(const GeneratorParams& generator, const string& path)
+{
+    SyntheticPublications publications;
+    AuthorsGraph graph;
+
+    graph.setBuildThreads(generator.threads);
+    generatePublications(generator, publications);
+    loadSynthetic(publications, graph);
+
+    if(!graph.saveSnapshot(path))
+    {
+        fprintf(stderr, "Nie można zapisać pliku %s\n", path.c_str());
+        return false;
+    }
+
+    fprintf(stderr, "%s: %d autorów, %zu krawędzi\n", path.c_str(), graph.getAuthorsCount(), graph.getEdgesCount());
+    return true;
+}
+}
+
+
+/**
+ * \brief Funkcja startowa programu pomiarowego
+ * \return Zwraca 0 w przypadku powodzenia, 1 dla niepoprawnych argumentow, 2 w przypadku bledu zapisu
+ */
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    if(!parseArguments(argc, argv, options))
+    {
+        printUsage(stderr);
+        return 1;
+    }
+
+    if(options.help)
+    {
+        printUsage(stdout);
+        return 0;
+    }
+
+    GeneratorParams generator;
+    generator.model = options.model;
+    generator.authors = options.startCount;
+    generator.degree = options.degree;
+    generator.seed = options.seed;
+    generator.threads = options.threads;
+
+    if(!options.snapshot.empty())
+        return writeSnapshot(generator, options.snapshot) ? 0 : 2;
+
+    Benchmark benchmark(options.warmups, options.repetitions);
+    vector<BenchmarkRow> rows;
+
+    for(size_t i = 0; i < options.algorithms.size(); ++i)
+    {
+        BenchmarkPlan plan;
+        string algorithm = options.algorithms[i];
+        int threads = options.threads;
+
+        plan.startCount = options.startCount;
+        plan.step = options.step;
+        plan.stepNo = options.stepNo;
+        plan.generator = generator;
+        plan.publicationsOnly = options.publicationsOnly;
+        plan.bipartite = options.bipartite;
+        plan.measureLoading = i == 0; // ladowanie i indeks nie zaleza od algorytmu - mierzone raz
+        plan.indexQueries = i == 0 ? options.indexQueries : 0;
+        plan.indexThreads = threads;
+        plan.orders = options.orders;
+        plan.compressed = options.compressed && (algorithm == "bfs" || algorithm.compare(0, 8, "dijkstra") == 0); // pozostale rozwijaja CSR
+        plan.algorithm = algorithm;
+        plan.solve = [algorithm, threads](AuthorsGraph& graph) { return graph.getRanks(algorithm, threads); };
+        plan.rankComplexity = algorithm.compare(0, 8, "dijkstra") == 0 ? Benchmark::logLinear : Benchmark::linear;
+
+        auto series = benchmark.run(plan, [&](int percent)
+        {
+            fprintf(stderr, "\r%s: %d%%", algorithm.c_str(), percent);
+        });
+        fputc('\n', stderr);
+
+        rows.insert(rows.end(), series.begin(), series.end());
+    }
+
+    ofstream file;
+    if(!options.output.empty())
+        file.open(options.output);
+
+    ostream& out = options.output.empty() ? cout : file;
+
+    if(options.json)
+        Benchmark::writeJson(out, rows);
+    else
+        Benchmark::writeCsv(out, rows);
+
+    out.flush();
+    return out ? 0 : 2;
+}
@@ -0,0 +1,439 @@
+/**
+ * \file   benchmark.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Pomiary czasu ladowania grafu i wyznaczania rang - rozgrzewka, powtorzenia i statystyki probek
+ */
+
+#include "benchmark.h"
+#include "generator.h"
+#include "distanceindex.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+namespace
+{
+/**
+ * \brief Wartosci krytyczne rozkladu t-Studenta dla dwustronnego przedzialu 95%, dla 1..30 stopni swobody
+ */
+const double T_CRITICAL_95[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+/**
+ * \brief Zapisuje napis jako literal JSON
+ */
+void writeJsonString(ostream& out, const string& s)
+{
+    out << '"';
+    for(char c: s)
+    {
+        if(c == '"' || c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+/**
+ * \brief Sprzetowy licznik chybien ostatniego poziomu pamieci podrecznej (perf_event_open) dla biezacego procesu,
+ * wliczajacy watki tworzone podczas pomiaru. Poza systemem Linux, bez uprawnien do licznikow (perf_event_paranoid)
+ * lub na maszynie wirtualnej bez nich licznik jest niedostepny
+ */
+class CacheMissCounter
+{
+    int fd; // deskryptor licznika lub -1
+
+public:
+    CacheMissCounter() : fd(-1)
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if(fd >= 0)
+            close(fd);
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    /**
+     * \brief Zlicza chybienia podczas wykonania funkcji
+     * \return Zwraca liczbe chybien lub -1, jesli licznik jest niedostepny
+     */
+    template<class Run>
+    int64_t count(Run run)
+    {
+#ifdef __linux__
+        uint64_t misses;
+
+        if(fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            run();
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            if(read(fd, &misses, sizeof(misses)) == sizeof(misses))
+                return misses;
+        }
+#endif
+        run();
+        return -1;
+    }
+};
+
+/**
+ * \brief Przelicza statystyki serii zapytan na czasy jednego zapytania
+ */
+BenchmarkStats perQuery(BenchmarkStats stats, int queries)
+{
+    for(double* value: {&stats.min, &stats.median, &stats.p95, &stats.mean, &stats.stddev, &stats.ciLow, &stats.ciHigh})
+        *value /= queries;
+
+    return stats;
+}
+}
+
+
+const int Benchmark::BIDIRECTIONAL_QUERIES = 1000;
+
+
+Benchmark::Benchmark(int warmups, int repetitions) : warmups(max(0, warmups)), repetitions(max(1, repetitions))
+{}
+
+BenchmarkStats Benchmark::summarize(vector<double> samples)
+{
+    BenchmarkStats stats;
+    size_t n = samples.size();
+
+    if(n == 0)
+        return stats;
+
+    sort(samples.begin(), samples.end());
+
+    stats.samples = n;
+    stats.min = samples[0];
+    stats.median = n % 2 ? samples[n/2] : (samples[n/2 - 1] + samples[n/2]) / 2;
+    stats.p95 = samples[(size_t)ceil(0.95 * n) - 1]; // percentyl metoda najblizszej rangi
+    stats.mean = accumulate(samples.begin(), samples.end(), 0.0) / n;
+
+    if(n > 1)
+    {
+        double squares = 0;
+        for(double s: samples)
+            squares += (s - stats.mean) * (s - stats.mean);
+
+        stats.stddev = sqrt(squares / (n - 1));
+
+        double t = n - 1 <= 30 ? T_CRITICAL_95[n - 2] : 1.96;
+        double margin = t * stats.stddev / sqrt((double)n);
+        stats.ciLow = stats.mean - margin;
+        stats.ciHigh = stats.mean + margin;
+    }
+    else
+        stats.ciLow = stats.ciHigh = stats.mean;
+
+    return stats;
+}
+
+vector<BenchmarkRow> Benchmark::run(const BenchmarkPlan &plan, function<void(int)> progress) const
+{
+    vector<BenchmarkRow> rows;
+    AuthorsGraph graph;
+    vector<string> authors;
+    vector<vector<string>> publications;
+    SyntheticPublications generated;
+    GeneratorParams params = plan.generator;
+    bool quadratic = params.model == QUADRATIC;
+    auto cancelled = [&]{ return plan.progress && plan.progress->isCancelled(); };
+
+    params.progress = plan.progress;
+    graph.setBipartite(plan.bipartite);
+    graph.setBuildThreads(params.threads);
+    graph.setProgress(plan.progress);
+
+    //Dane modelu kwadratowego ladowane sa z list nazwisk, pozostale - bezposrednio z identyfikatorow
+    string loading = !quadratic ? "builder" : plan.publicationsOnly ? "publications" : "full";
+
+    if(plan.bipartite)
+        loading += "-bipartite";
+
+    auto loadInto = [&](AuthorsGraph& target)
+    {
+        if(!quadratic)
+            loadSynthetic(generated, target);
+        else if(plan.publicationsOnly)
+            target.loadGraph(publications);
+        else
+            target.loadGraph(authors, publications);
+    };
+    auto load = [&]{ loadInto(graph); };
+
+    for(int i = 0; i < plan.stepNo; ++i)
+    {
+        BenchmarkRow row;
+        row.authors = plan.startCount + i * plan.step;
+        row.model = modelName(params.model);
+
+        params.authors = row.authors;
+        params.seed = plan.generator.seed + i;
+
+        if(quadratic)
+            generateInput(row.authors, authors, publications, params.seed);
+        else
+            generatePublications(params, generated);
+
+        if(plan.progress)
+            plan.progress->setSteps(i, plan.stepNo);
+
+        load(); // poza mierzonym obszarem - liczba krawedzi i graf fazy rang
+        row.edges = graph.getEdgesCount();
+
+        if(cancelled())
+            break;
+
+        if(plan.measureLoading) // faza ladowania - kazde powtorzenie buduje graf od nowa
+        {
+            row.phase = "load";
+            row.name = loading;
+            row.stats = measure(load);
+
+            if(cancelled())
+                break;
+
+            rows.push_back(row);
+        }
+
+        if(plan.solve) // faza rang - na zaladowanym grafie
+        {
+            row.phase = "rank";
+            row.name = plan.algorithm;
+            row.stats = measure([&]{ delete plan.solve(graph); });
+            row.bytes = graph.getAdjacencyBytes();
+
+            if(cancelled())
+                break;
+
+            rows.push_back(row);
+        }
+
+        if(plan.solve && plan.compressed) // faza list skompresowanych - ten sam graf, listy odczytywane w trakcie przegladania
+        {
+            AuthorsGraph compact;
+
+            compact.setBipartite(plan.bipartite);
+            compact.setBuildThreads(params.threads);
+            compact.setProgress(plan.progress);
+            compact.setCompressedAdjacency(true);
+            loadInto(compact);
+
+            row.phase = "compressed";
+            row.name = plan.algorithm;
+            row.stats = measure([&]{ delete plan.solve(compact); });
+            row.bytes = compact.getAdjacencyBytes();
+
+            if(cancelled())
+                break;
+
+            rows.push_back(row);
+        }
+
+        row.bytes = 0;
+
+        for(VertexOrder order: plan.solve ? plan.orders : vector<VertexOrder>()) // faza kolejnosci - ten sam graf przenumerowany
+        {
+            AuthorsGraph reordered;
+            CacheMissCounter counter;
+
+            reordered.setBipartite(plan.bipartite);
+            reordered.setBuildThreads(params.threads);
+            reordered.setProgress(plan.progress);
+            reordered.setVertexOrder(order);
+            loadInto(reordered);
+
+            row.phase = "order";
+            row.name = vertexOrderName(order);
+            row.stats = measure([&]{ delete plan.solve(reordered); });
+            row.cacheMisses = counter.count([&]{ delete plan.solve(reordered); }); // osobny przebieg, poza pomiarem czasu
+
+            if(cancelled())
+                break;
+
+            rows.push_back(row);
+        }
+
+        row.cacheMisses = -1;
+
+        if(cancelled())
+            break;
+
+        if(plan.indexQueries > 0 && row.authors > 0) // fazy indeksu odleglosci - na zaladowanym grafie, dla tych samych losowych par
+        {
+            DistanceIndex index;
+            vector<pair<AuthorsGraph::AuthorId, AuthorsGraph::AuthorId>> pairs(plan.indexQueries);
+            mt19937 random(params.seed);
+            uniform_int_distribution<AuthorsGraph::AuthorId> author(0, graph.getAuthorsCount() - 1);
+            bool built = true;
+
+            for(auto& query: pairs)
+                query = make_pair(author(random), author(random));
+
+            row.phase = "index";
+            row.name = "pll";
+            row.stats = measure([&]{ built = index.build(graph, plan.indexThreads) && built; });
+            row.bytes = index.getBytes();
+
+            if(cancelled())
+                break;
+
+            if(built) // srednica grafu nie przekracza DistanceIndex::MAX_DISTANCE
+            {
+                rows.push_back(row);
+
+                volatile int distance; // wynik zapytan musi zostac zapisany, aby nie zostaly pominiete
+                row.phase = "query";
+                row.bytes = 0;
+                row.stats = perQuery(measure([&]
+                {
+                    for(auto& query: pairs)
+                        distance = index.distance(query.first, query.second);
+                }), pairs.size());
+
+                rows.push_back(row);
+            }
+
+            AuthorsGraph::Path path;
+            int bidirectional = min(plan.indexQueries, BIDIRECTIONAL_QUERIES);
+
+            row.phase = "query";
+            row.name = "bidirectional";
+            row.bytes = 0;
+            row.stats = perQuery(measure([&]
+            {
+                for(int q = 0; q < bidirectional; ++q)
+                    graph.findPath(pairs[q].first, pairs[q].second, path);
+            }), bidirectional);
+
+            if(cancelled())
+                break;
+
+            rows.push_back(row);
+        }
+
+        if(plan.progress)
+            plan.progress->setSteps(i + 1, plan.stepNo);
+        if(progress)
+            progress(100 * (i + 1) / plan.stepNo);
+    }
+
+    computeQ(rows, "load", logLinear);
+    computeQ(rows, "rank", plan.rankComplexity ? plan.rankComplexity : linear);
+
+    return rows;
+}
+
+void Benchmark::computeQ(vector<BenchmarkRow> &rows, const string &phase, const function<double(int, int)> &complexity)
+{
+    vector<BenchmarkRow*> series;
+
+    for(auto& row: rows)
+        if(row.phase == phase)
+            series.push_back(&row);
+
+    if(series.empty())
+        return;
+
+    //Mediana serii - wiersz srodkowy, a dla parzystej liczby wierszy srednia dwoch srodkowych
+    size_t m = series.size() / 2;
+    double medianTime = series[m]->stats.median;
+    double medianTheory = complexity(series[m]->authors, series[m]->edges);
+
+    if(series.size() % 2 == 0)
+    {
+        medianTime = (medianTime + series[m-1]->stats.median) / 2;
+        medianTheory = (medianTheory + complexity(series[m-1]->authors, series[m-1]->edges)) / 2;
+    }
+
+    for(auto row: series)
+        row->q = row->stats.median / complexity(row->authors, row->edges) * medianTheory / medianTime;
+}
+
+double Benchmark::linear(int n, int v)
+{
+    return (double)n + v;
+}
+
+double Benchmark::logLinear(int n, int v)
+{
+    return v * log2((double)n);
+}
+
+void Benchmark::writeCsv(ostream &out, const vector<BenchmarkRow> &rows)
+{
+    out << "phase,name,model,authors,edges,samples,min_ms,median_ms,p95_ms,mean_ms,stddev_ms,ci95_low_ms,ci95_high_ms,q,bytes,llc_misses\n";
+    out << fixed << setprecision(6); // czasy zapytan sa rzedu mikrosekund
+
+    for(auto& row: rows)
+    {
+        const BenchmarkStats& s = row.stats;
+        out << row.phase << ',' << row.name << ',' << row.model << ',' << row.authors << ',' << row.edges << ',' << s.samples << ','
+            << s.min << ',' << s.median << ',' << s.p95 << ',' << s.mean << ',' << s.stddev << ','
+            << s.ciLow << ',' << s.ciHigh << ',' << row.q << ',' << row.bytes << ',' << row.cacheMisses << '\n';
+    }
+}
+
+void Benchmark::writeJson(ostream &out, const vector<BenchmarkRow> &rows)
+{
+    out << "[\n" << fixed << setprecision(6);
+
+    for(size_t i = 0; i < rows.size(); ++i)
+    {
+        const BenchmarkRow& row = rows[i];
+        const BenchmarkStats& s = row.stats;
+
+        out << "  {\"phase\": ";
+        writeJsonString(out, row.phase);
+        out << ", \"name\": ";
+        writeJsonString(out, row.name);
+        out << ", \"model\": ";
+        writeJsonString(out, row.model);
+        out << ", \"authors\": " << row.authors << ", \"edges\": " << row.edges << ", \"samples\": " << s.samples
+            << ", \"min_ms\": " << s.min << ", \"median_ms\": " << s.median << ", \"p95_ms\": " << s.p95
+            << ", \"mean_ms\": " << s.mean << ", \"stddev_ms\": " << s.stddev
+            << ", \"ci95_ms\": [" << s.ciLow << ", " << s.ciHigh << "], \"q\": " << row.q << ", \"bytes\": " << row.bytes
+            << ", \"llc_misses\": " << row.cacheMisses << '}'
+            << (i + 1 < rows.size() ? ",\n" : "\n");
+    }
+
+    out << "]\n";
+}
@@ -0,0 +1,177 @@
+/**
+ * \file   benchmark.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Pomiary czasu ladowania grafu i wyznaczania rang - rozgrzewka, powtorzenia i statystyki probek
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "authorsgraph.h"
+#include "generator.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <ostream>
+
+/**
+ * \brief Statystyki serii pomiarow (w milisekundach czasu rzeczywistego)
+ */
+struct BenchmarkStats
+{
+    int samples = 0; /**< Liczba pomiarow */
+    double min = 0; /**< Najkrotszy czas */
+    double median = 0; /**< Mediana */
+    double p95 = 0; /**< 95. percentyl */
+    double mean = 0; /**< Srednia */
+    double stddev = 0; /**< Odchylenie standardowe proby */
+    double ciLow = 0; /**< Dolna granica 95% przedzialu ufnosci sredniej (rozklad t-Studenta) */
+    double ciHigh = 0; /**< Gorna granica 95% przedzialu ufnosci sredniej */
+};
+
+/**
+ * \brief Wynik pomiaru jednej fazy dla jednego rozmiaru danych
+ */
+struct BenchmarkRow
+{
+    string phase; /**< Faza: "load" (ladowanie grafu), "rank" (wyznaczanie rang), "order" (wyznaczanie rang po przenumerowaniu
+                       wezlow), "compressed" (wyznaczanie rang na skompresowanych listach wspolpracownikow), "index" (budowa
+                       indeksu odleglosci) lub "query" (odleglosc pary autorow - czasy w przeliczeniu na jedno zapytanie) */
+    string name; /**< Sposob ladowania (full, publications, builder), nazwa algorytmu, kolejnosc wezlow (natural, degree,
+                      bfs, rcm) lub metoda zapytan (pll, bidirectional) */
+    string model; /**< Model wygenerowanych danych */
+    int authors = 0; /**< Liczba autorow (n) */
+    int edges = 0; /**< Liczba krawedzi grafu (v) */
+    BenchmarkStats stats; /**< Statystyki pomiarow */
+    double q = 0; /**< Wspolczynnik q - stosunek t(n)/T(n) do t/T mediany serii */
+    uint64_t bytes = 0; /**< Fazy rank i compressed: rozmiar struktur sasiedztwa grafu, faza index: rozmiar indeksu (w bajtach) */
+    int64_t cacheMisses = -1; /**< Faza order: chybienia ostatniego poziomu pamieci podrecznej podczas jednego wyznaczenia
+                                   rang (-1, jesli licznik sprzetowy jest niedostepny) */
+};
+
+/**
+ * \brief Plan serii pomiarow dla kolejnych rozmiarow losowych danych
+ */
+struct BenchmarkPlan
+{
+    int startCount = 100; /**< Najmniejsza liczba autorow */
+    int step = 100; /**< Przyrost liczby autorow */
+    int stepNo = 10; /**< Liczba rozmiarow */
+    GeneratorParams generator; /**< Parametry generatora danych. Liczba autorow wynika z serii, a ziarno rozmiaru i to seed + i */
+    bool publicationsOnly = false; /**< Sposob ladowania grafu (dla modelu QUADRATIC) */
+    bool bipartite = false; /**< Czy graf przechowuje publikacje jako hiperkrawedzie (patrz AuthorsGraph::setBipartite) */
+    bool measureLoading = true; /**< Czy mierzyc faze ladowania */
+    string algorithm; /**< Nazwa algorytmu fazy rang */
+    function<AuthorsGraph::RankList *(AuthorsGraph&)> solve; /**< Algorytm fazy rang (pusty - faza pomijana) */
+    function<double(int n, int v)> rankComplexity; /**< Zlozonosc teoretyczna fazy rang, T(n,v) */
+    int indexQueries = 0; /**< Liczba losowych par autorow fazy query (0 - fazy index i query pomijane). Dwukierunkowy BFS
+                               mierzony jest na co najwyzej BIDIRECTIONAL_QUERIES parach */
+    int indexThreads = 1; /**< Liczba watkow budowy indeksu odleglosci */
+    bool compressed = false; /**< Czy mierzyc faze compressed - algorytm fazy rang na grafie ze skompresowanymi listami
+                                  (patrz AuthorsGraph::setCompressedAdjacency) */
+    vector<VertexOrder> orders; /**< Kolejnosci wezlow fazy order - algorytm fazy rang mierzony na grafie przenumerowanym
+                                     kazda z nich (puste - faza pomijana) */
+    JobProgress* progress = nullptr; /**< Postep zadania: kroki to rozmiary serii, a generator i graf zglaszaja prace (lub nullptr) */
+};
+
+/**
+ * \brief Pomiary czasu rzeczywistego z rozgrzewka i powtorzeniami.
+ *
+ * Kazdy pomiar poprzedzaja przebiegi rozgrzewajace (nie wliczane), a nastepnie mierzona funkcja wykonywana jest
+ * zadana liczbe razy zegarem monotonicznym (steady_clock). Ladowanie i wyznaczanie rang mierzone sa osobno,
+ * na tych samych danych. Opcjonalnie mierzona jest budowa indeksu odleglosci (DistanceIndex) i czas zapytania
+ * o odleglosc pary autorow - z indeksu oraz dwukierunkowym BFS - a takze wplyw kolejnosci wezlow na czas wyznaczania
+ * rang i liczbe chybien pamieci podrecznej (licznik sprzetowy perf, dostepny w systemie Linux) oraz koszt odczytu
+ * skompresowanych list wspolpracownikow wobec ich rozmiaru. Wyniki mozna zapisac w formacie CSV lub JSON.
+ */
+class Benchmark
+{
+    int warmups; /**< Liczba przebiegow rozgrzewajacych */
+    int repetitions; /**< Liczba mierzonych powtorzen */
+
+public:
+    static const int BIDIRECTIONAL_QUERIES; /**< Najwieksza liczba par mierzonych dwukierunkowym BFS */
+
+    /**
+     * \brief Konstruktor
+     * \param warmups Liczba przebiegow rozgrzewajacych
+     * \param repetitions Liczba mierzonych powtorzen (co najmniej 1)
+     */
+    Benchmark(int warmups = 1, int repetitions = 5);
+
+    /**
+     * \brief Mierzy czas wykonania funkcji
+     * \param run Mierzona funkcja
+     * \return Zwraca statystyki powtorzen
+     */
+    template<class Run>
+    BenchmarkStats measure(Run run) const
+    {
+        vector<double> samples;
+
+        for(int i = 0; i < warmups; ++i)
+            run();
+
+        for(int i = 0; i < repetitions; ++i)
+        {
+            auto start = chrono::steady_clock::now();
+            run();
+            auto stop = chrono::steady_clock::now();
+            samples.push_back(chrono::duration<double, milli>(stop - start).count());
+        }
+
+        return summarize(samples);
+    }
+
+    /**
+     * \brief Wykonuje serie pomiarow wedlug planu
+     * \param plan Plan serii
+     * \param progress Funkcja informowana o postepie (0-100), moze byc pusta
+     * \return Zwraca wiersze faz load, rank, compressed, order, index i query dla kolejnych rozmiarow, z wyznaczonym wspolczynnikiem q.
+     * Po przerwaniu zadania (plan.progress) zwraca wiersze zmierzone do tej chwili
+     */
+    vector<BenchmarkRow> run(const BenchmarkPlan& plan, function<void(int)> progress = nullptr) const;
+
+    /**
+     * \brief Wyznacza statystyki probek
+     * \param samples Czasy pomiarow
+     * \return Zwraca statystyki
+     */
+    static BenchmarkStats summarize(vector<double> samples);
+
+    /**
+     * \brief Wyznacza wspolczynnik q wierszy jednej fazy wzgledem wiersza srodkowego (mediany serii)
+     * \param rows Wiersze
+     * \param phase Faza, dla ktorej wyznaczany jest wspolczynnik
+     * \param complexity Zlozonosc teoretyczna T(n,v)
+     */
+    static void computeQ(vector<BenchmarkRow>& rows, const string& phase, const function<double(int, int)>& complexity);
+
+    /**
+     * \brief Zlozonosc liniowa: T(n,v) = n + v
+     */
+    static double linear(int n, int v);
+
+    /**
+     * \brief Zlozonosc: T(n,v) = v log(n)
+     */
+    static double logLinear(int n, int v);
+
+    /**
+     * \brief Zapisuje wiersze w formacie CSV (z naglowkiem)
+     * \param out Strumien wyjsciowy
+     * \param rows Wiersze
+     */
+    static void writeCsv(ostream& out, const vector<BenchmarkRow>& rows);
+
+    /**
+     * \brief Zapisuje wiersze jako tablice obiektow JSON
+     * \param out Strumien wyjsciowy
+     * \param rows Wiersze
+     */
+    static void writeJson(ostream& out, const vector<BenchmarkRow>& rows);
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,208 @@
+/**
+ * \file   bitmap.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Gesta mapa bitowa indeksowana identyfikatorem autora - jadra skalarne i AVX2
+ */
+
+#include "bitmap.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITMAP_HAS_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+size_t countScalar(const uint64_t* w, size_t n)
+{
+    size_t result = 0;
+    for(size_t i = 0; i < n; ++i)
+        result += bitCount(w[i]);
+    return result;
+}
+
+bool anyScalar(const uint64_t* w, size_t n)
+{
+    for(size_t i = 0; i < n; ++i)
+        if(w[i])
+            return true;
+    return false;
+}
+
+void orScalar(uint64_t* dst, const uint64_t* src, size_t n)
+{
+    for(size_t i = 0; i < n; ++i)
+        dst[i] |= src[i];
+}
+
+bool testAnyScalar(const uint64_t* w, const uint32_t* ids, size_t n)
+{
+    for(size_t i = 0; i < n; ++i)
+        if((w[ids[i] >> 6] >> (ids[i] & 63)) & 1)
+            return true;
+    return false;
+}
+
+#ifdef BITMAP_HAS_AVX2_KERNELS
+
+/* Zliczanie bitow metoda tablicy polbajtow (vpshufb) i sumowania bajtow (vpsadbw) */
+__attribute__((target("avx2")))
+size_t countAvx2(const uint64_t* w, size_t n)
+{
+    const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                            0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+        __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+        __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + countScalar(w + i, n - i);
+}
+
+__attribute__((target("avx2")))
+bool anyAvx2(const uint64_t* w, size_t n)
+{
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+        if(!_mm256_testz_si256(v, v))
+            return true;
+    }
+
+    return anyScalar(w + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void orAvx2(uint64_t* dst, const uint64_t* src, size_t n)
+{
+    size_t i = 0;
+
+    for(; i + 4 <= n; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(a, b));
+    }
+
+    orScalar(dst + i, src + i, n - i);
+}
+
+/*
+ * Osiem indeksow naraz: pobranie 32-bitowych polowek slow zawierajacych bity (vpgatherdd), przesuniecie kazdego
+ * pola o numer bitu (vpsrlvd) i test najmlodszych bitow. Polowka i mlodszy bit slowa - kolejnosc bajtow x86
+ */
+__attribute__((target("avx2")))
+bool testAnyAvx2(const uint64_t* w, const uint32_t* ids, size_t n)
+{
+    const int* halves = reinterpret_cast<const int*>(w);
+    const __m256i lowBits = _mm256_set1_epi32(31);
+    const __m256i one = _mm256_set1_epi32(1);
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+        __m256i half = _mm256_i32gather_epi32(halves, _mm256_srli_epi32(index, 5), 4);
+        __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(half, _mm256_and_si256(index, lowBits)), one);
+
+        if(!_mm256_testz_si256(bit, bit))
+            return true;
+    }
+
+    return testAnyScalar(w, ids + i, n - i);
+}
+
+bool detectAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+bool detectAvx2()
+{
+    return false;
+}
+
+#endif
+
+/**
+ * \brief Zestaw jader wybrany raz, przy starcie programu
+ */
+struct Kernels
+{
+    bool avx2;
+    size_t (*count)(const uint64_t*, size_t);
+    bool (*any)(const uint64_t*, size_t);
+    void (*orWith)(uint64_t*, const uint64_t*, size_t);
+    bool (*testAny)(const uint64_t*, const uint32_t*, size_t);
+
+    Kernels() : avx2(detectAvx2()), count(countScalar), any(anyScalar), orWith(orScalar), testAny(testAnyScalar)
+    {
+#ifdef BITMAP_HAS_AVX2_KERNELS
+        if(avx2)
+        {
+            count = countAvx2;
+            any = anyAvx2;
+            orWith = orAvx2;
+            testAny = testAnyAvx2;
+        }
+#endif
+    }
+};
+
+const Kernels& kernels()
+{
+    static const Kernels k;
+    return k;
+}
+
+}
+
+
+void Bitmap::clear()
+{
+    std::fill(words.begin(), words.end(), 0);
+}
+
+size_t Bitmap::count() const
+{
+    return kernels().count(words.data(), words.size());
+}
+
+bool Bitmap::any() const
+{
+    return kernels().any(words.data(), words.size());
+}
+
+void Bitmap::orWith(const Bitmap &other)
+{
+    kernels().orWith(words.data(), other.words.data(), std::min(words.size(), other.words.size()));
+}
+
+bool Bitmap::testAnyWide(const uint32_t *ids, size_t n) const
+{
+    return kernels().testAny(words.data(), ids, n);
+}
+
+bool Bitmap::usesAvx2()
+{
+    return kernels().avx2;
+}
@@ -0,0 +1,171 @@
+/**
+ * \file   bitmap.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Gesta mapa bitowa indeksowana identyfikatorem autora, stosowana jako zbior odwiedzonych wezlow i front BFS
+ */
+
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include "bitops.h"
+
+/**
+ * \brief Gesta mapa bitowa.
+ *
+ * Przechowuje jeden bit na autora w slowach 64-bitowych. Operacje na calej mapie (zliczanie, sumowanie, test
+ * pustosci) oraz test listy indeksow (testAny) korzystaja z jader AVX2, jesli procesor je udostepnia, a w przeciwnym
+ * wypadku z wersji skalarnych.
+ * Bity poza zakresem [0, size()) sa zawsze wyzerowane.
+ */
+class Bitmap
+{
+    std::vector<uint64_t> words; /**< Slowa mapy */
+    size_t bits; /**< Liczba bitow */
+
+public:
+    /**
+     * \brief Konstruktor mapy
+     * \param n Liczba bitow (wszystkie wyzerowane)
+     */
+    explicit Bitmap(size_t n = 0) : words((n + 63) / 64, 0), bits(n)
+    {}
+
+    /**
+     * \brief Zmienia rozmiar mapy i zeruje wszystkie bity
+     * \param n Nowa liczba bitow
+     */
+    void resize(size_t n)
+    {
+        words.assign((n + 63) / 64, 0);
+        bits = n;
+    }
+
+    /**
+     * \brief Zwraca liczbe bitow mapy
+     * \return Zwraca liczbe bitow mapy
+     */
+    size_t size() const
+    {
+        return bits;
+    }
+
+    /**
+     * \brief Ustawia bit
+     * \param i Indeks bitu
+     */
+    void set(size_t i)
+    {
+        words[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+
+    /**
+     * \brief Sprawdza bit
+     * \param i Indeks bitu
+     * \return Zwraca true, jesli bit jest ustawiony
+     */
+    bool test(size_t i) const
+    {
+        return (words[i >> 6] >> (i & 63)) & 1;
+    }
+
+    /**
+     * \brief Sprawdza czy ustawiono bit ktoregokolwiek z indeksow listy (np. czy wspolpracownik autora nalezy do frontu).
+     * Krotkie listy sprawdzane sa bezposrednio, dluzsze - jadrem AVX2 po osiem indeksow naraz
+     * \param ids Indeksy bitow
+     * \param n Liczba indeksow
+     * \return Zwraca true, jesli ktorys z bitow jest ustawiony
+     */
+    bool testAny(const uint32_t* ids, size_t n) const
+    {
+        size_t head = n < 16 ? n : 16; // trafienie pada zwykle na poczatku listy - poczatek sprawdzany bezposrednio
+
+        for(size_t i = 0; i < head; ++i)
+            if(test(ids[i]))
+                return true;
+
+        return n > head && testAnyWide(ids + head, n - head);
+    }
+
+    /**
+     * \brief Zeruje wszystkie bity
+     */
+    void clear();
+
+    /**
+     * \brief Zlicza ustawione bity
+     * \return Zwraca liczbe ustawionych bitow
+     */
+    size_t count() const;
+
+    /**
+     * \brief Sprawdza czy ustawiono jakikolwiek bit
+     * \return Zwraca true, jesli mapa nie jest pusta
+     */
+    bool any() const;
+
+    /**
+     * \brief Dodaje do mapy bity innej mapy (this |= other)
+     * \param other Mapa tego samego rozmiaru
+     */
+    void orWith(const Bitmap& other);
+
+    /**
+     * \brief Zamienia zawartosc dwoch map w czasie stalym
+     * \param other Druga mapa
+     */
+    void swap(Bitmap& other)
+    {
+        words.swap(other.words);
+        std::swap(bits, other.bits);
+    }
+
+    /**
+     * \brief Wywoluje funkcje dla kazdego ustawionego bitu, w kolejnosci rosnacej
+     * \param f Funkcja przyjmujaca indeks bitu
+     */
+    template<class F>
+    void forEachSet(F f) const
+    {
+        for(size_t w = 0; w < words.size(); ++w)
+            for(uint64_t word = words[w]; word; word &= word - 1)
+                f(w * 64 + lowestBit(word));
+    }
+
+    /**
+     * \brief Wywoluje funkcje dla kazdego wyzerowanego bitu, w kolejnosci rosnacej.
+     * Slowa w calosci ustawione sa pomijane jednym porownaniem
+     * \param f Funkcja przyjmujaca indeks bitu
+     */
+    template<class F>
+    void forEachUnset(F f) const
+    {
+        for(size_t w = 0; w < words.size(); ++w)
+        {
+            uint64_t word = ~words[w];
+            if(w == words.size() - 1 && (bits & 63))
+                word &= (uint64_t(1) << (bits & 63)) - 1;
+
+            for(; word; word &= word - 1)
+                f(w * 64 + lowestBit(word));
+        }
+    }
+
+    /**
+     * \brief Informuje czy operacje na calej mapie korzystaja z AVX2
+     * \return Zwraca true, jesli wybrano jadra AVX2
+     */
+    static bool usesAvx2();
+
+private:
+    /**
+     * \brief Wersja testAny dla dlugich list - wybrane jadro
+     */
+    bool testAnyWide(const uint32_t* ids, size_t n) const;
+};
+
+#endif // BITMAP_H
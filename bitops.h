@@ -0,0 +1,81 @@
+/**
+ * \file   bitops.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Operacje na bitach slow (najmlodszy i najstarszy ustawiony bit, liczba bitow) niezalezne od kompilatora
+ */
+
+#ifndef BITOPS_H
+#define BITOPS_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/*
+ * GCC i Clang korzystaja z funkcji wbudowanych, MSVC - z funkcji _BitScan*. Wersja przenosna w pozostalych
+ * przypadkach. Wszystkie funkcje wymagaja niezerowego argumentu, z wyjatkiem bitCount.
+ */
+
+/**
+ * \brief Zwraca indeks najmlodszego ustawionego bitu slowa (niezerowego)
+ */
+inline int lowestBit(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if(_BitScanForward(&index, uint32_t(word)))
+        return index;
+    _BitScanForward(&index, uint32_t(word >> 32));
+    return index + 32;
+#else
+    int index = 0;
+    for(; !(word & 1); word >>= 1)
+        ++index;
+    return index;
+#endif
+}
+
+/**
+ * \brief Zwraca indeks najstarszego ustawionego bitu slowa (niezerowego)
+ */
+inline int highestBit(uint32_t word)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(word);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, word);
+    return index;
+#else
+    int index = 0;
+    for(; word >>= 1; )
+        ++index;
+    return index;
+#endif
+}
+
+/**
+ * \brief Zwraca liczbe ustawionych bitow slowa
+ */
+inline int bitCount(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return int((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+#endif // BITOPS_H
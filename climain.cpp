@@ -0,0 +1,537 @@
+/**
+ * \file   climain.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Start konsolowej wersji programu - rozwiazywanie plikow XML i list krawedzi bez GUI
+ */
+
+#include "authorsgraph.h"
+#include "xmlscenarioreader.h"
+#include "scenariosolver.h"
+#include <QFile>
+#include <QString>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+
+namespace
+{
+/**
+ * \brief Parametry wywolania
+ */
+struct Options
+{
+    string algorithm = "bfs"; /**< Nazwa algorytmu grafowego (patrz AuthorsGraph::getAlgorithmNames) */
+    bool publicationsOnly = false; /**< Sposob ladowania scenariuszy XML */
+    bool bipartite = false; /**< Czy przechowywac publikacje jako hiperkrawedzie (patrz AuthorsGraph::setBipartite) */
+    int threads = 1; /**< Liczba watkow */
+    string root = "Erdos"; /**< Autor, od ktorego liczone sa rangi */
+    vector<string> paths; /**< Autorzy, dla ktorych zamiast rang wyznaczane sa lancuchy wspolpracy z autorem root */
+    bool byRank = false; /**< Czy wypisywac rangi w kolejnosci rang (w przeciwnym razie alfabetycznie) */
+    bool histogram = false; /**< Czy zamiast rang wypisywac liczby autorow o kolejnych rangach */
+    bool health = false; /**< Czy zamiast rang wypisywac podsumowanie spojnych skladowych grafu */
+    string output; /**< Plik wynikowy (pusty - wyjscie standardowe) */
+    vector<string> inputs; /**< Pliki wejsciowe */
+    bool help = false; /**< Czy wyswietlic opis wywolania */
+};
+
+/**
+ * \brief Wypisuje opis wywolania
+ * \param out Strumien wyjsciowy
+ */
+void printUsage(FILE* out)
+{
+    fputs("Użycie: erdos-cli [opcje] plik...\n"
+          "Pliki z rozszerzeniem .xml czytane są jako scenariusze, migawki grafu rozpoznawane są po sygnaturze,\n"
+          "a pozostałe pliki czytane są jako listy krawędzi (jedna publikacja w linii, nazwiska rozdzielone\n"
+          "tabulatorami lub spacjami, # rozpoczyna komentarz).\n"
+          "\n"
+          "  -a, --algorithm NAZWA                       algorytm grafowy (domyślnie bfs): bfs, dijkstra, dobfs, parallel,\n"
+          "                                              dijkstra-bucket, dijkstra-radix, dijkstra-4ary, dijkstra-pairing\n"
+          "  -l, --loading full|publications             ładowanie scenariuszy XML (domyślnie full)\n"
+          "  -s, --storage clique|bipartite              reprezentacja publikacji (domyślnie clique): pary współautorów\n"
+          "                                              lub graf dwudzielny autor–publikacja (mniej pamięci dla dużych zespołów)\n"
+          "  -t, --threads N                             liczba wątków (domyślnie liczba rdzeni)\n"
+          "  -r, --root NAZWISKO                         autor, od którego liczone są rangi (domyślnie Erdos)\n"
+          "  -p, --path NAZWISKO                         zamiast rang wypisuje najkrótszy łańcuch współpracy autora -r\n"
+          "                                              z podanym autorem (opcję można powtórzyć; bez scenariuszy XML)\n"
+          "  -f, --format name|rank|histogram|health     wynik (domyślnie name): rangi alfabetycznie, rangi w kolejności rang,\n"
+          "                                              liczby autorów o kolejnych rangach lub podsumowanie spójnych\n"
+          "                                              składowych grafu (dwa ostatnie bez scenariuszy XML)\n"
+          "  -o, --output PLIK                           plik wynikowy (domyślnie wyjście standardowe)\n"
+          "  -h, --help                                  wyświetla ten opis\n", out);
+}
+
+/**
+ * \brief Odczytuje parametry wywolania
+ * \param argc Liczba argumentow
+ * \param argv Argumenty
+ * \param options Zmienna, do ktorej zostana zapisane parametry
+ * \return Zwraca true, jesli argumenty sa poprawne
+ */
+bool parseArguments(int argc, char* argv[], Options& options)
+{
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for(int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+
+        if(arg == "-h" || arg == "--help")
+        {
+            options.help = true;
+            return true;
+        }
+
+        if(arg.empty() || arg[0] != '-')
+        {
+            options.inputs.push_back(arg);
+            continue;
+        }
+
+        if(i + 1 == argc) // kazda opcja poza --help wymaga wartosci
+        {
+            fprintf(stderr, "Brak wartości opcji %s\n", arg.c_str());
+            return false;
+        }
+
+        string value = argv[++i];
+
+        if(arg == "-a" || arg == "--algorithm")
+        {
+            auto& names = AuthorsGraph::getAlgorithmNames();
+            if(find(names.begin(), names.end(), value) == names.end())
+            {
+                fprintf(stderr, "Nieznany algorytm: %s\n", value.c_str());
+                return false;
+            }
+            options.algorithm = value;
+        }
+        else if(arg == "-l" || arg == "--loading")
+        {
+            if(value != "full" && value != "publications")
+            {
+                fprintf(stderr, "Nieznany sposób ładowania: %s\n", value.c_str());
+                return false;
+            }
+            options.publicationsOnly = value == "publications";
+        }
+        else if(arg == "-s" || arg == "--storage")
+        {
+            if(value != "clique" && value != "bipartite")
+            {
+                fprintf(stderr, "Nieznana reprezentacja: %s\n", value.c_str());
+                return false;
+            }
+            options.bipartite = value == "bipartite";
+        }
+        else if(arg == "-t" || arg == "--threads")
+        {
+            options.threads = atoi(value.c_str());
+            if(options.threads < 1)
+            {
+                fprintf(stderr, "Niepoprawna liczba wątków: %s\n", value.c_str());
+                return false;
+            }
+        }
+        else if(arg == "-r" || arg == "--root")
+            options.root = value;
+        else if(arg == "-p" || arg == "--path")
+            options.paths.push_back(value);
+        else if(arg == "-f" || arg == "--format")
+        {
+            if(value != "name" && value != "rank" && value != "histogram" && value != "health")
+            {
+                fprintf(stderr, "Nieznany format wyniku: %s\n", value.c_str());
+                return false;
+            }
+            options.byRank = value == "rank";
+            options.histogram = value == "histogram";
+            options.health = value == "health";
+        }
+        else if(arg == "-o" || arg == "--output")
+            options.output = value;
+        else
+        {
+            fprintf(stderr, "Nieznana opcja: %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if(options.inputs.empty())
+    {
+        fputs("Nie podano plików wejściowych\n", stderr);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Oblicza rangi wybranym algorytmem
+ * \param graph Zaladowany graf
+ * \param options Parametry wywolania
+ * \return Zwraca wskaznik na liste par nazwisko-ranga
+ */
+AuthorsGraph::RankList * getRanks(AuthorsGraph& graph, const Options& options)
+{
+    graph.setRoot(options.root);
+    return graph.getRanks(options.algorithm, options.threads);
+}
+
+/**
+ * \brief Zapisuje rangi w postaci linii "nazwisko<TAB>ranga" (inf dla autorow nieosiagalnych)
+ * \param out Strumien wyjsciowy
+ * \param title Tytul zapisywany w linii komentarza przed rangami
+ * \param ranks Lista par nazwisko-ranga w kolejnosci alfabetycznej
+ * \param byRank Czy wypisac rangi w kolejnosci rang (autorzy o tej samej randze alfabetycznie)
+ */
+template<class Ranks>
+void writeRanks(FILE* out, const string& title, const Ranks& ranks, bool byRank)
+{
+    vector<uint32_t> positions(ranks.size());
+
+    for(size_t i = 0; i < positions.size(); ++i)
+        positions[i] = i;
+
+    if(byRank)
+        RankList::sortByRank(positions, true, [&ranks](uint32_t i) { return ranks[i].second; });
+
+    fprintf(out, "# %s\n", title.c_str());
+
+    for(auto i: positions)
+    {
+        const auto& rank = ranks[i];
+        fwrite(rank.first.data(), 1, rank.first.size(), out);
+
+        if(rank.second == AuthorsGraph::INFINITE_RANK)
+            fputs("\tinf\n", out);
+        else
+            fprintf(out, "\t%d\n", rank.second);
+    }
+}
+
+/**
+ * \brief Zapisuje liczby autorow o kolejnych rangach w postaci linii "ranga<TAB>liczba" (inf dla autorow nieosiagalnych)
+ * \param out Strumien wyjsciowy
+ * \param title Tytul zapisywany w linii komentarza
+ * \param ranks Lista rang
+ */
+void writeHistogram(FILE* out, const string& title, const AuthorsGraph::RankList& ranks)
+{
+    vector<size_t> counts = ranks.histogram();
+
+    fprintf(out, "# %s\n", title.c_str());
+
+    for(size_t rank = 0; rank + 1 < counts.size(); ++rank)
+        fprintf(out, "%zu\t%zu\n", rank, counts[rank]);
+
+    fprintf(out, "inf\t%zu\n", counts.back());
+}
+
+/**
+ * \brief Zapisuje podsumowanie spojnych skladowych grafu: liczbe autorow i skladowych, rozmiar i udzial najwiekszej
+ * skladowej, liczbe autorow bez wspolpracownikow oraz skladowa autora root
+ * \param out Strumien wyjsciowy
+ * \param title Tytul zapisywany w linii komentarza
+ * \param graph Zaladowany graf
+ * \param options Parametry wywolania
+ */
+void writeHealth(FILE* out, const string& title, AuthorsGraph& graph, const Options& options)
+{
+    const ComponentIndex& components = graph.getComponents();
+    int authors = graph.getAuthorsCount();
+    AuthorsGraph::AuthorId root;
+
+    fprintf(out, "# %s\n", title.c_str());
+    fprintf(out, "autorzy\t%d\n", authors);
+    fprintf(out, "składowe\t%u\n", components.getComponentsCount());
+    fprintf(out, "największa składowa\t%u\t%.2f%%\n", components.getLargestSize(),
+            authors ? 100.0 * components.getLargestSize() / authors : 0.0);
+    fprintf(out, "autorzy bez współpracowników\t%u\n", components.getIsolatedCount());
+
+    if(graph.findAuthor(options.root, root))
+        fprintf(out, "składowa autora %s\t%u\n", options.root.c_str(), components.getComponentSize(root));
+}
+
+/**
+ * \brief Zapisuje lancuchy wspolpracy autora root z autorami options.paths: linia komentarza z odlegloscia, a nastepnie
+ * kolejni autorzy lancucha (w trybie dwudzielnym z numerem publikacji laczacej autora z poprzednim)
+ * \param out Strumien wyjsciowy
+ * \param title Tytul zapisywany w liniach komentarza
+ * \param graph Zaladowany graf
+ * \param options Parametry wywolania
+ */
+void writePaths(FILE* out, const string& title, AuthorsGraph& graph, const Options& options)
+{
+    AuthorsGraph::Path path;
+
+    for(auto& target: options.paths)
+    {
+        fprintf(out, "# %s: %s -> %s", title.c_str(), options.root.c_str(), target.c_str());
+
+        if(!graph.findPath(options.root, target, path))
+        {
+            fputs(" (autora nie ma w grafie)\n", out);
+            continue;
+        }
+
+        if(path.distance == AuthorsGraph::INFINITE_RANK)
+        {
+            fputs(" (brak łańcucha)\n", out);
+            continue;
+        }
+
+        fprintf(out, " (odległość %d, odwiedzono %zu autorów)\n", path.distance, path.visited);
+
+        for(size_t i = 0; i < path.authors.size(); ++i)
+        {
+            string_view name = graph.getName(path.authors[i]);
+            fwrite(name.data(), 1, name.size(), out);
+
+            if(i > 0 && !path.publications.empty()) // publikacje numerowane od 1, w kolejnosci pliku
+                fprintf(out, "\tpublikacja %u", path.publications[i - 1] + 1);
+
+            fputc('\n', out);
+        }
+    }
+}
+
+/**
+ * \brief Zapisuje wynik dla zaladowanego grafu: rangi, ich histogram, podsumowanie skladowych lub, jesli podano opcje --path, lancuchy wspolpracy
+ * \param out Strumien wyjsciowy
+ * \param title Tytul zapisywany w liniach komentarza
+ * \param graph Zaladowany graf
+ * \param options Parametry wywolania
+ */
+void writeResult(FILE* out, const string& title, AuthorsGraph& graph, const Options& options)
+{
+    if(!options.paths.empty())
+    {
+        writePaths(out, title, graph, options);
+        return;
+    }
+
+    if(options.health)
+    {
+        writeHealth(out, title, graph, options);
+        return;
+    }
+
+    AuthorsGraph::RankList * ranks = getRanks(graph, options);
+
+    if(options.histogram)
+        writeHistogram(out, title, *ranks);
+    else
+        writeRanks(out, title, *ranks, options.byRank);
+
+    delete ranks;
+}
+
+/**
+ * \brief Rozwiazuje wszystkie scenariusze pliku XML na puli watkow
+ * \param path Sciezka do pliku
+ * \param options Parametry wywolania
+ * \param out Strumien wyjsciowy
+ * \return Zwraca true, jesli plik byl poprawny i zawieral co najmniej jeden scenariusz
+ */
+bool solveXml(const string& path, const Options& options, FILE* out)
+{
+    if(!options.paths.empty())
+    {
+        fprintf(stderr, "%s: opcja --path nie dotyczy scenariuszy XML\n", path.c_str());
+        return false;
+    }
+
+    if(options.histogram || options.health)
+    {
+        fprintf(stderr, "%s: formaty histogram i health nie dotycza scenariuszy XML\n", path.c_str());
+        return false;
+    }
+
+    QFile file(QString::fromStdString(path));
+
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        fprintf(stderr, "Nie można otworzyć pliku %s\n", path.c_str());
+        return false;
+    }
+
+    XmlScenarioReader reader(&file);
+    ScenarioData scenario;
+    ScenarioResult result;
+    int count = 0;
+    Options scenarioOptions = options;
+
+    scenarioOptions.threads = 1; // scenariusze rozwiazywane sa wspolbieznie przez pule - jeden watek na scenariusz
+
+    ScenarioSolver solver(options.threads, options.publicationsOnly, options.bipartite, [&scenarioOptions](AuthorsGraph& graph)
+    {
+        return getRanks(graph, scenarioOptions);
+    });
+
+    auto write = [&]
+    {
+        writeRanks(out, path + " scenariusz " + to_string(result.index + 1), *result.ranks, options.byRank);
+    };
+
+    while(reader.readScenario(scenario))
+    {
+        solver.submit(move(scenario));
+        ++count;
+
+        while(solver.tryNext(result))
+            write();
+    }
+
+    if(reader.hasError() || count == 0)
+    {
+        fprintf(stderr, "%s: %s\n", path.c_str(),
+                reader.hasError() ? reader.errorString().toUtf8().constData() : "brak scenariuszy");
+        return false;
+    }
+
+    solver.finish();
+    while(solver.next(result))
+        write();
+
+    return true;
+}
+
+/**
+ * \brief Laduje migawke grafu lub liste krawedzi (po publikacjach) i oblicza rangi lub lancuchy wspolpracy
+ * \param path Sciezka do pliku
+ * \param options Parametry wywolania
+ * \param out Strumien wyjsciowy
+ * \return Zwraca true, jesli plik udalo sie odczytac
+ */
+bool solveEdgeList(const string& path, const Options& options, FILE* out)
+{
+    AuthorsGraph graph;
+
+    if(graph.loadSnapshot(path)) // migawka binarna, np. graf zapisany przez erdos-bench --snapshot
+    {
+        writeResult(out, path, graph, options);
+        return true;
+    }
+
+    graph.setBipartite(options.bipartite);
+    graph.setBuildThreads(options.threads);
+
+    ifstream file(path);
+
+    if(!file)
+    {
+        fprintf(stderr, "Nie można otworzyć pliku %s\n", path.c_str());
+        return false;
+    }
+
+    vector<AuthorsGraph::AuthorId> publication;
+    string line;
+
+    while(getline(file, line))
+    {
+        if(!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        //Nazwiska rozdzielane sa tabulatorami, a jesli linia ich nie zawiera - bialymi znakami
+        const char* separators = line.find('\t') != string::npos ? "\t" : " \t";
+        string_view rest(line);
+
+        publication.clear();
+        while(!rest.empty())
+        {
+            size_t begin = rest.find_first_not_of(separators);
+            if(begin == string_view::npos)
+                break;
+
+            size_t end = rest.find_first_of(separators, begin);
+            if(end == string_view::npos)
+                end = rest.size();
+
+            publication.push_back(graph.addAuthor(rest.substr(begin, end - begin)));
+            rest.remove_prefix(end);
+        }
+
+        graph.addPublication(publication);
+    }
+
+    if(file.bad())
+    {
+        fprintf(stderr, "Błąd odczytu pliku %s\n", path.c_str());
+        return false;
+    }
+
+    graph.freeze();
+    writeResult(out, path, graph, options);
+
+    return true;
+}
+
+/**
+ * \brief Sprawdza rozszerzenie pliku
+ * \param path Sciezka do pliku
+ * \return Zwraca true, jesli plik ma rozszerzenie .xml (bez wzgledu na wielkosc liter)
+ */
+bool isXml(const string& path)
+{
+    if(path.size() < 4)
+        return false;
+
+    string extension = path.substr(path.size() - 4);
+    transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return tolower(c); });
+
+    return extension == ".xml";
+}
+}
+
+
+/**
+ * \brief Funkcja startowa konsolowej wersji programu
+ * \return Zwraca 0 w przypadku powodzenia, 1 dla niepoprawnych argumentow, 2 w przypadku bledu pliku
+ */
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    if(!parseArguments(argc, argv, options))
+    {
+        printUsage(stderr);
+        return 1;
+    }
+
+    if(options.help)
+    {
+        printUsage(stdout);
+        return 0;
+    }
+
+    FILE* out = stdout;
+
+    if(!options.output.empty() && !(out = fopen(options.output.c_str(), "w")))
+    {
+        fprintf(stderr, "Nie można utworzyć pliku %s\n", options.output.c_str());
+        return 2;
+    }
+
+    vector<char> buffer(1 << 20); // duzy bufor - wynik zapisywany jest linia po linii
+    setvbuf(out, buffer.data(), _IOFBF, buffer.size());
+
+    bool ok = true;
+
+    for(auto& path: options.inputs)
+        ok = (isXml(path) ? solveXml(path, options, out) : solveEdgeList(path, options, out)) && ok;
+
+    if(fclose(out) != 0)
+        ok = false;
+
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,254 @@
+/**
+ * \file   components.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Indeks spojnych skladowych grafu autorow (las zbiorow rozlacznych)
+ */
+
+#include "components.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace std;
+
+
+ComponentIndex::ComponentIndex()
+{
+    clear();
+}
+
+void ComponentIndex::clear()
+{
+    vector<AuthorId>().swap(parent);
+    vector<uint32_t>().swap(treeSize);
+    vector<uint32_t>().swap(componentIds);
+    vector<uint32_t>().swap(componentSizes);
+    vector<AuthorId>().swap(nextMember);
+    component = nullptr;
+    sizes = nullptr;
+    authors = 0;
+    numbered = 0;
+    components = 0;
+    largest = 0;
+    isolated = 0;
+    frozen = false;
+    mapped = false;
+}
+
+void ComponentIndex::addAuthor()
+{
+    if(!frozen)
+    {
+        parent.push_back(parent.size());
+        treeSize.push_back(1);
+        return;
+    }
+
+    detach();
+
+    componentIds.push_back(componentSizes.size()); // nowa skladowa jednoelementowa
+    componentSizes.push_back(1);
+    nextMember.push_back(authors);
+    ++authors;
+    ++components;
+    ++isolated;
+    largest = max(largest, 1u);
+    attachOwned();
+}
+
+void ComponentIndex::resize(size_t count)
+{
+    while(getAuthorsCount() < count)
+        addAuthor();
+}
+
+ComponentIndex::AuthorId ComponentIndex::find(AuthorId a)
+{
+    while(parent[a] != a)
+    {
+        parent[a] = parent[parent[a]];
+        a = parent[a];
+    }
+
+    return a;
+}
+
+void ComponentIndex::unite(AuthorId a, AuthorId b)
+{
+    if(!frozen)
+    {
+        a = find(a);
+        b = find(b);
+
+        if(a == b)
+            return;
+
+        if(treeSize[a] < treeSize[b]) // mniejsze drzewo podpinane pod wieksze - drzewa pozostaja plytkie
+            swap(a, b);
+
+        parent[b] = a;
+        treeSize[a] += treeSize[b];
+        return;
+    }
+
+    if(component[a] == component[b]) // krawedz wewnatrz skladowej - tablice bez zmian
+        return;
+
+    detach();
+
+    if(componentSizes[componentIds[a]] < componentSizes[componentIds[b]]) // przenumerowywana jest mniejsza skladowa
+        swap(a, b);
+
+    uint32_t kept = componentIds[a];
+    uint32_t merged = componentIds[b];
+
+    isolated -= (componentSizes[kept] == 1) + (componentSizes[merged] == 1);
+    componentSizes[kept] += componentSizes[merged];
+    componentSizes[merged] = 0;
+    largest = max(largest, componentSizes[kept]);
+    --components;
+
+    AuthorId member = b;
+    do
+    {
+        componentIds[member] = kept;
+        member = nextMember[member];
+    }
+    while(member != b);
+
+    swap(nextMember[a], nextMember[b]); // zamiana nastepnikow laczy dwa pierscienie w jeden
+}
+
+void ComponentIndex::relabel(const vector<AuthorId> &newId)
+{
+    if(!frozen)
+    {
+        vector<AuthorId> relabeledParent(parent.size());
+        vector<uint32_t> relabeledSize(treeSize.size());
+
+        for(AuthorId a = 0; a < parent.size(); ++a) // las zachowuje ksztalt - zmieniaja sie jedynie etykiety
+        {
+            relabeledParent[newId[a]] = newId[parent[a]];
+            relabeledSize[newId[a]] = treeSize[a];
+        }
+
+        parent.swap(relabeledParent);
+        treeSize.swap(relabeledSize);
+        return;
+    }
+
+    detach();
+
+    vector<uint32_t> relabeledIds(authors);
+    vector<AuthorId> relabeledNext(authors);
+
+    for(AuthorId a = 0; a < authors; ++a) // pierscienie zachowuja ksztalt - zmieniaja sie jedynie etykiety
+    {
+        relabeledIds[newId[a]] = componentIds[a];
+        relabeledNext[newId[a]] = newId[nextMember[a]];
+    }
+
+    componentIds.swap(relabeledIds);
+    nextMember.swap(relabeledNext);
+    attachOwned();
+}
+
+void ComponentIndex::freeze()
+{
+    if(frozen)
+        return;
+
+    const uint32_t NONE = numeric_limits<uint32_t>::max();
+    vector<uint32_t> rootComponent(parent.size(), NONE); // numer skladowej nadany korzeniowi
+    vector<AuthorId> lastMember; // ostatni autor pierscienia skladowej
+
+    authors = parent.size();
+    componentIds.resize(authors);
+    nextMember.resize(authors);
+    componentSizes.clear();
+    largest = 0;
+    isolated = 0;
+
+    for(AuthorId a = 0; a < authors; ++a) // kolejnosc identyfikatorow - numeracja niezalezna od ksztaltu lasu
+    {
+        AuthorId root = find(a);
+        uint32_t c = rootComponent[root];
+
+        if(c == NONE)
+        {
+            c = rootComponent[root] = componentSizes.size();
+            componentSizes.push_back(treeSize[root]);
+            lastMember.push_back(a);
+            largest = max(largest, treeSize[root]);
+            isolated += treeSize[root] == 1;
+            nextMember[a] = a;
+        }
+        else // autor wstawiany do pierscienia za ostatnim autorem skladowej
+        {
+            nextMember[a] = nextMember[lastMember[c]];
+            nextMember[lastMember[c]] = a;
+            lastMember[c] = a;
+        }
+
+        componentIds[a] = c;
+    }
+
+    components = numbered = componentSizes.size();
+    vector<AuthorId>().swap(parent); // las nie jest juz potrzebny - unite aktualizuje tablice
+    vector<uint32_t>().swap(treeSize);
+    frozen = true;
+    attachOwned();
+}
+
+void ComponentIndex::attach(const uint32_t *mappedIds, size_t authorCount, const uint32_t *mappedSizes, size_t slotCount,
+                            uint32_t count, uint32_t largestSize, uint32_t isolatedCount)
+{
+    clear();
+    component = mappedIds;
+    sizes = mappedSizes;
+    authors = authorCount;
+    numbered = slotCount;
+    components = count;
+    largest = largestSize;
+    isolated = isolatedCount;
+    frozen = true;
+    mapped = true;
+}
+
+void ComponentIndex::detach()
+{
+    if(!mapped)
+        return;
+
+    vector<AuthorId> lastMember(numbered, numeric_limits<AuthorId>::max());
+
+    componentIds.assign(component, component + authors);
+    componentSizes.assign(sizes, sizes + numbered);
+    nextMember.resize(authors);
+
+    for(AuthorId a = 0; a < authors; ++a) // pierscienie nie sa zapisywane w migawce - budowane z numerow skladowych
+    {
+        uint32_t c = componentIds[a];
+
+        if(lastMember[c] == numeric_limits<AuthorId>::max())
+            nextMember[a] = a;
+        else
+        {
+            nextMember[a] = nextMember[lastMember[c]];
+            nextMember[lastMember[c]] = a;
+        }
+
+        lastMember[c] = a;
+    }
+
+    mapped = false;
+    attachOwned();
+}
+
+void ComponentIndex::attachOwned()
+{
+    component = componentIds.data();
+    sizes = componentSizes.data();
+    numbered = componentSizes.size();
+}
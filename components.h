@@ -0,0 +1,207 @@
+/**
+ * \file   components.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Indeks spojnych skladowych grafu autorow (las zbiorow rozlacznych)
+ */
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \brief Spojne skladowe grafu, utrzymywane podczas dodawania krawedzi.
+ *
+ * W trakcie ladowania autorzy i krawedzie trafiaja do lasu zbiorow rozlacznych (laczenie wedlug rozmiaru,
+ * skracanie sciezek przez polowienie), co kosztuje prawie stala prace na krawedz. Pierwsze zamrozenie (freeze)
+ * zamienia las na gesta tablice numerow skladowych i ich rozmiary (skladowe numerowane w kolejnosci najmniejszego
+ * identyfikatora autora), wiec pytanie o spojnosc pary autorow lub rozmiar skladowej ma stala zlozonosc.
+ *
+ * Po zamrozeniu tablice pozostaja aktualne: autorzy skladowej tworza pierscien, a polaczenie dwoch skladowych
+ * przenumerowuje jedynie autorow mniejszej z nich (kazdy autor przenumerowywany jest co najwyzej log n razy).
+ * Polaczona skladowa zachowuje numer wiekszej, a numer mniejszej pozostaje pusty (rozmiar 0). Tablice moga
+ * tez wskazywac na dane odwzorowane z migawki (attach) - sa wtedy kopiowane dopiero przy pierwszej zmianie.
+ */
+class ComponentIndex
+{
+public:
+    typedef uint32_t AuthorId; /**< Identyfikator autora grafu */
+
+    /** Konstruktor pustego indeksu */
+    ComponentIndex();
+
+    /**
+     * \brief Usuwa wszystkich autorow
+     */
+    void clear();
+
+    /**
+     * \brief Dodaje autora jako osobna skladowa. Autorzy otrzymuja kolejne identyfikatory
+     */
+    void addAuthor();
+
+    /**
+     * \brief Dodaje autorow o identyfikatorach mniejszych niz count, ktorych jeszcze nie ma w indeksie
+     * \param count Liczba autorow grafu
+     */
+    void resize(size_t count);
+
+    /**
+     * \brief Laczy skladowe autorow krawedzia
+     * \param a Identyfikator pierwszego autora
+     * \param b Identyfikator drugiego autora
+     */
+    void unite(AuthorId a, AuthorId b);
+
+    /**
+     * \brief Przenumerowuje autorow (przenumerowanie wezlow grafu). Numery skladowych nie zmieniaja sie
+     * \param newId Nowy identyfikator kazdego autora (permutacja)
+     */
+    void relabel(const std::vector<AuthorId>& newId);
+
+    /**
+     * \brief Zamienia las na tablice skladowych. Po pierwszym zamrozeniu tablice sa aktualizowane przez unite,
+     * wiec kolejne wywolania nic nie robia
+     */
+    void freeze();
+
+    /**
+     * \brief Informuje czy tablice skladowych sa aktualne
+     */
+    bool isFrozen() const
+    {
+        return frozen;
+    }
+
+    /**
+     * \brief Wskazuje tablice skladowych odwzorowane z migawki (bez kopiowania). Zastepuje dotychczasowa zawartosc
+     * \param mappedIds Numer skladowej kazdego autora
+     * \param authorCount Liczba autorow
+     * \param mappedSizes Rozmiary skladowych indeksowane numerem (0 - numer pusty)
+     * \param slotCount Liczba numerow skladowych (elementow mappedSizes)
+     * \param count Liczba skladowych (niepustych numerow)
+     * \param largestSize Rozmiar najwiekszej skladowej
+     * \param isolatedCount Liczba skladowych jednoelementowych
+     */
+    void attach(const uint32_t* mappedIds, size_t authorCount, const uint32_t* mappedSizes, size_t slotCount,
+                uint32_t count, uint32_t largestSize, uint32_t isolatedCount);
+
+    /**
+     * \brief Kopiuje tablice odwzorowane z migawki do tablic wlasnych (przed usunieciem odwzorowania). Wywolywane
+     * rowniez automatycznie przy pierwszej zmianie skladowych
+     */
+    void detach();
+
+    /**
+     * \brief Zwraca numery skladowych autorow (getAuthorsCount elementow). Wymaga zamrozenia
+     */
+    const uint32_t* componentsData() const
+    {
+        return component;
+    }
+
+    /**
+     * \brief Zwraca rozmiary skladowych indeksowane numerem (getSlotsCount elementow, 0 - numer pusty). Wymaga zamrozenia
+     */
+    const uint32_t* sizesData() const
+    {
+        return sizes;
+    }
+
+    /**
+     * \brief Zwraca liczbe autorow indeksu
+     */
+    size_t getAuthorsCount() const
+    {
+        return frozen ? authors : parent.size();
+    }
+
+    /**
+     * \brief Zwraca liczbe numerow skladowych, lacznie z pustymi. Wymaga zamrozenia
+     */
+    size_t getSlotsCount() const
+    {
+        return numbered;
+    }
+
+    /**
+     * \brief Zwraca numer skladowej autora. Wymaga zamrozenia
+     * \param a Identyfikator autora
+     */
+    uint32_t getComponent(AuthorId a) const
+    {
+        return component[a];
+    }
+
+    /**
+     * \brief Zwraca liczbe autorow skladowej, do ktorej nalezy autor. Wymaga zamrozenia
+     * \param a Identyfikator autora
+     */
+    uint32_t getComponentSize(AuthorId a) const
+    {
+        return sizes[component[a]];
+    }
+
+    /**
+     * \brief Informuje czy autorzy naleza do tej samej skladowej (istnieje lancuch wspolpracy). Wymaga zamrozenia
+     */
+    bool isConnected(AuthorId a, AuthorId b) const
+    {
+        return component[a] == component[b];
+    }
+
+    /**
+     * \brief Zwraca liczbe skladowych. Wymaga zamrozenia
+     */
+    uint32_t getComponentsCount() const
+    {
+        return components;
+    }
+
+    /**
+     * \brief Zwraca liczbe autorow najwiekszej skladowej. Wymaga zamrozenia
+     */
+    uint32_t getLargestSize() const
+    {
+        return largest;
+    }
+
+    /**
+     * \brief Zwraca liczbe autorow bez wspolpracownikow (skladowych jednoelementowych). Wymaga zamrozenia
+     */
+    uint32_t getIsolatedCount() const
+    {
+        return isolated;
+    }
+
+private:
+    std::vector<AuthorId> parent; /**< Las (przed zamrozeniem): rodzic autora (korzen wskazuje na siebie) */
+    std::vector<uint32_t> treeSize; /**< Las: liczba autorow drzewa (wazna dla korzeni) */
+    std::vector<uint32_t> componentIds; /**< Numer skladowej autora (tablice wlasne) */
+    std::vector<uint32_t> componentSizes; /**< Rozmiary skladowych indeksowane numerem (tablice wlasne) */
+    std::vector<AuthorId> nextMember; /**< Nastepny autor pierscienia skladowej (tablice wlasne) */
+    const uint32_t* component; /**< Widok: numer skladowej autora - tablica wlasna lub odwzorowana */
+    const uint32_t* sizes; /**< Widok: rozmiary skladowych */
+    size_t authors; /**< Liczba autorow zamrozonego indeksu */
+    size_t numbered; /**< Liczba numerow skladowych */
+    uint32_t components; /**< Liczba skladowych */
+    uint32_t largest; /**< Rozmiar najwiekszej skladowej */
+    uint32_t isolated; /**< Liczba skladowych jednoelementowych */
+    bool frozen; /**< Czy tablice skladowych sa aktualne (las zostal zamieniony) */
+    bool mapped; /**< Czy widoki wskazuja na dane odwzorowane */
+
+    /**
+     * \brief Zwraca korzen drzewa autora, polowiac sciezke
+     */
+    AuthorId find(AuthorId a);
+
+    /**
+     * \brief Ustawia widoki na tablice wlasne
+     */
+    void attachOwned();
+};
+
+#endif // COMPONENTS_H
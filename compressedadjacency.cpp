@@ -0,0 +1,334 @@
+/**
+ * \file   compressedadjacency.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Skompresowane listy wspolpracownikow - kodowanie roznicowe i grupowe liczby o zmiennej dlugosci
+ */
+
+#include "compressedadjacency.h"
+#include "parallel.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADJACENCY_HAS_SSSE3_KERNELS
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+size_t varintSize(uint64_t x)
+{
+    size_t size = 1;
+
+    for(; x >= 0x80; x >>= 7)
+        ++size;
+
+    return size;
+}
+
+uint8_t* writeVarint(uint8_t* out, uint64_t x)
+{
+    for(; x >= 0x80; x >>= 7)
+        *out++ = uint8_t(x) | 0x80;
+
+    *out++ = uint8_t(x);
+    return out;
+}
+
+uint64_t readVarint(const uint8_t*& in)
+{
+    uint64_t x = 0;
+
+    for(int shift = 0; ; shift += 7)
+    {
+        uint8_t byte = *in++;
+        x |= uint64_t(byte & 0x7f) << shift;
+
+        if(!(byte & 0x80))
+            return x;
+    }
+}
+
+/* Liczba bajtow roznicy w grupie (1-4) */
+int groupLength(uint32_t gap)
+{
+    return gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+}
+
+/* Roznica ze znakiem jako liczba bez znaku: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ... */
+uint64_t zigzag(int64_t x)
+{
+    return (uint64_t(x) << 1) ^ uint64_t(x >> 63);
+}
+
+int64_t unzigzag(uint64_t x)
+{
+    return int64_t(x >> 1) ^ -int64_t(x & 1);
+}
+
+/**
+ * \brief Rozmiar zakodowanej listy w bajtach (patrz encodeList)
+ */
+size_t listSize(uint32_t v, const uint32_t* list, uint32_t degree)
+{
+    if(degree == 0)
+        return varintSize(0);
+
+    size_t size = varintSize(degree) + varintSize(zigzag(int64_t(list[0]) - v));
+    uint32_t grouped = (degree - 1) / 4 * 4; // roznice zapisywane grupami
+
+    for(uint32_t i = 1; i < degree; ++i)
+        size += i <= grouped ? groupLength(list[i] - list[i-1]) : varintSize(list[i] - list[i-1]);
+
+    return size + grouped / 4; // bajty sterujace grup
+}
+
+/**
+ * \brief Koduje liste: liczba wspolpracownikow, roznica pierwszego i v, grupy po cztery roznice, pozostale roznice
+ */
+void encodeList(uint32_t v, const uint32_t* list, uint32_t degree, uint8_t* out)
+{
+    out = writeVarint(out, degree);
+
+    if(degree == 0)
+        return;
+
+    out = writeVarint(out, zigzag(int64_t(list[0]) - v));
+
+    uint32_t grouped = (degree - 1) / 4 * 4;
+    uint32_t i = 1;
+
+    for(; i <= grouped; i += 4)
+    {
+        uint8_t& control = *out++;
+        control = 0;
+
+        for(int lane = 0; lane < 4; ++lane)
+        {
+            uint32_t gap = list[i + lane] - list[i + lane - 1];
+            int length = groupLength(gap);
+
+            control |= (length - 1) << (2 * lane);
+
+            for(int b = 0; b < length; ++b) // kolejnosc bajtow od najmlodszego
+                *out++ = uint8_t(gap >> (8 * b));
+        }
+    }
+
+    for(; i < degree; ++i)
+        out = writeVarint(out, list[i] - list[i-1]);
+}
+
+const uint8_t* decodeGroupsScalar(const uint8_t* in, size_t groups, uint32_t base, uint32_t* out)
+{
+    for(size_t g = 0; g < groups; ++g)
+    {
+        uint8_t control = *in++;
+
+        for(int lane = 0; lane < 4; ++lane)
+        {
+            int length = ((control >> (2 * lane)) & 3) + 1;
+            uint32_t gap = 0;
+
+            for(int b = 0; b < length; ++b)
+                gap |= uint32_t(in[b]) << (8 * b);
+
+            base += gap;
+            *out++ = base;
+            in += length;
+        }
+    }
+
+    return in;
+}
+
+#ifdef ADJACENCY_HAS_SSSE3_KERNELS
+
+/**
+ * \brief Tablice jadra SSSE3 indeksowane bajtem sterujacym grupy: liczba bajtow wartosci i maska pshufb
+ * rozmieszczajaca bajty czterech roznic w 32-bitowych polach (brakujace bajty zerowane)
+ */
+struct GroupTables
+{
+    uint8_t length[256];
+    alignas(16) uint8_t shuffle[256][16];
+
+    GroupTables()
+    {
+        for(int control = 0; control < 256; ++control)
+        {
+            int position = 0;
+
+            for(int lane = 0; lane < 4; ++lane)
+            {
+                int bytes = ((control >> (2 * lane)) & 3) + 1;
+
+                for(int b = 0; b < 4; ++b)
+                    shuffle[control][4 * lane + b] = b < bytes ? position + b : 0x80;
+
+                position += bytes;
+            }
+
+            length[control] = position;
+        }
+    }
+};
+
+const GroupTables& groupTables()
+{
+    static const GroupTables tables;
+    return tables;
+}
+
+/* Grupa: rozmieszczenie bajtow (pshufb), suma prefiksowa czterech roznic i dodanie poprzedniego wspolpracownika */
+__attribute__((target("ssse3")))
+const uint8_t* decodeGroupsSsse3(const uint8_t* in, size_t groups, uint32_t base, uint32_t* out)
+{
+    const GroupTables& tables = groupTables();
+    __m128i previous = _mm_set1_epi32(base);
+
+    for(size_t g = 0; g < groups; ++g)
+    {
+        uint8_t control = *in;
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 1)); // bufor uzupelniony o PADDING bajtow
+        __m128i gaps = _mm_shuffle_epi8(bytes, _mm_load_si128(reinterpret_cast<const __m128i*>(tables.shuffle[control])));
+
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+        gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+
+        __m128i values = _mm_add_epi32(gaps, previous);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), values);
+
+        previous = _mm_shuffle_epi32(values, 0xFF); // ostatni wspolpracownik grupy we wszystkich polach
+        out += 4;
+        in += 1 + tables.length[control];
+    }
+
+    return in;
+}
+
+bool detectSsse3()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+
+#else
+
+bool detectSsse3()
+{
+    return false;
+}
+
+#endif
+
+/**
+ * \brief Jadro odczytu grup wybrane raz, przy pierwszym uzyciu
+ */
+struct Kernels
+{
+    bool ssse3;
+    const uint8_t* (*decodeGroups)(const uint8_t*, size_t, uint32_t, uint32_t*);
+
+    Kernels() : ssse3(detectSsse3()), decodeGroups(decodeGroupsScalar)
+    {
+#ifdef ADJACENCY_HAS_SSSE3_KERNELS
+        if(ssse3)
+        {
+            groupTables();
+            decodeGroups = decodeGroupsSsse3;
+        }
+#endif
+    }
+};
+
+const Kernels& kernels()
+{
+    static const Kernels k;
+    return k;
+}
+
+}
+
+
+const size_t CompressedAdjacency::PADDING = 16;
+
+
+CompressedAdjacency::CompressedAdjacency()
+{
+    clear();
+}
+
+void CompressedAdjacency::clear()
+{
+    std::vector<uint64_t>().swap(starts);
+    std::vector<uint8_t>().swap(data);
+    maxDegree = 0;
+    entries = 0;
+}
+
+void CompressedAdjacency::build(const uint32_t *offsets, const AuthorId *neighbors, size_t nodeCount, int threads)
+{
+    starts.assign(nodeCount + 1, 0);
+    entries = offsets[nodeCount];
+    maxDegree = 0;
+
+    parallelFor(nodeCount, 4096, threads, nullptr, [&](uint64_t begin, uint64_t end)
+    {
+        for(uint64_t v = begin; v < end; ++v) // rozmiary list - poczatki wyznaczane sa sumami prefiksowymi
+            starts[v+1] = listSize(v, neighbors + offsets[v], offsets[v+1] - offsets[v]);
+    });
+
+    for(size_t v = 0; v < nodeCount; ++v)
+    {
+        starts[v+1] += starts[v];
+        maxDegree = std::max(maxDegree, offsets[v+1] - offsets[v]);
+    }
+
+    data.assign(starts[nodeCount] + PADDING, 0);
+
+    parallelFor(nodeCount, 4096, threads, nullptr, [&](uint64_t begin, uint64_t end)
+    {
+        for(uint64_t v = begin; v < end; ++v)
+            encodeList(v, neighbors + offsets[v], offsets[v+1] - offsets[v], data.data() + starts[v]);
+    });
+}
+
+uint32_t CompressedAdjacency::decode(AuthorId v, AuthorId *out) const
+{
+    const uint8_t* in = data.data() + starts[v];
+    uint32_t degree = readVarint(in);
+
+    if(degree == 0)
+        return 0;
+
+    AuthorId current = int64_t(v) + unzigzag(readVarint(in));
+    size_t groups = (degree - 1) / 4;
+
+    out[0] = current;
+    in = kernels().decodeGroups(in, groups, current, out + 1);
+
+    if(groups > 0)
+        current = out[4 * groups];
+
+    for(uint32_t i = 1 + 4 * groups; i < degree; ++i)
+    {
+        current += readVarint(in);
+        out[i] = current;
+    }
+
+    return degree;
+}
+
+uint32_t CompressedAdjacency::getDegree(AuthorId v) const
+{
+    const uint8_t* in = data.data() + starts[v];
+    return readVarint(in);
+}
+
+bool CompressedAdjacency::usesSimd()
+{
+    return kernels().ssse3;
+}
@@ -0,0 +1,111 @@
+/**
+ * \file   compressedadjacency.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Skompresowane listy wspolpracownikow - kodowanie roznicowe i grupowe liczby o zmiennej dlugosci
+ */
+
+#ifndef COMPRESSEDADJACENCY_H
+#define COMPRESSEDADJACENCY_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \brief Listy wspolpracownikow zamrozonego grafu zapisane w postaci skompresowanej.
+ *
+ * Lista autora v to: liczba wspolpracownikow, roznica pierwszego wspolpracownika i v (ze znakiem, kodowanie
+ * zigzag), a dalej roznice kolejnych wspolpracownikow posortowanej listy. Roznice zapisywane sa grupami po cztery:
+ * bajt sterujacy (dlugosci 1-4 bajty, po 2 bity) i bajty wartosci (group varint), a pozostale 0-3 roznice oraz
+ * naglowek listy - jako liczby o zmiennej dlugosci (7 bitow na bajt). Po przenumerowaniu wezlow (setVertexOrder)
+ * roznice sa male, wiec wiekszosc wpisow zajmuje jeden bajt zamiast czterech.
+ *
+ * Grupy odczytywane sa jadrem SSSE3 (jedno przestawienie bajtow pshufb i suma prefiksowa na grupe), jesli procesor
+ * je udostepnia, a w przeciwnym wypadku wersja skalarna. Bufor jest uzupelniony zerami, wiec jadra moga czytac
+ * po 16 bajtow bez sprawdzania konca danych.
+ */
+class CompressedAdjacency
+{
+public:
+    typedef uint32_t AuthorId; /**< Identyfikator autora grafu */
+
+    static const size_t PADDING; /**< Liczba zerowych bajtow za ostatnia lista */
+
+    /** Konstruktor pustych list */
+    CompressedAdjacency();
+
+    /**
+     * \brief Koduje listy CSR
+     * \param offsets Poczatki list (nodeCount+1 elementow)
+     * \param neighbors Posortowane listy wspolpracownikow bez powtorzen
+     * \param nodeCount Liczba autorow
+     * \param threads Liczba watkow kodowania
+     */
+    void build(const uint32_t* offsets, const AuthorId* neighbors, size_t nodeCount, int threads);
+
+    /**
+     * \brief Usuwa listy i zwalnia pamiec
+     */
+    void clear();
+
+    /**
+     * \brief Informuje czy listy sa puste (nie zbudowano ich)
+     */
+    bool empty() const
+    {
+        return starts.empty();
+    }
+
+    /**
+     * \brief Odczytuje liste wspolpracownikow autora
+     * \param v Identyfikator autora
+     * \param out Bufor na co najmniej getMaxDegree() identyfikatorow
+     * \return Zwraca liczbe wspolpracownikow zapisanych do bufora (rosnaco)
+     */
+    uint32_t decode(AuthorId v, AuthorId* out) const;
+
+    /**
+     * \brief Zwraca liczbe wspolpracownikow autora (odczytuje jedynie naglowek listy)
+     * \param v Identyfikator autora
+     */
+    uint32_t getDegree(AuthorId v) const;
+
+    /**
+     * \brief Zwraca najwieksza liczbe wspolpracownikow autora - rozmiar bufora decode
+     */
+    uint32_t getMaxDegree() const
+    {
+        return maxDegree;
+    }
+
+    /**
+     * \brief Zwraca liczbe zakodowanych wpisow (dwukrotnosc liczby krawedzi)
+     */
+    size_t getEntries() const
+    {
+        return entries;
+    }
+
+    /**
+     * \brief Zwraca rozmiar list w pamieci: zakodowane bajty i poczatki list
+     */
+    size_t getBytes() const
+    {
+        return data.size() + starts.size() * sizeof(uint64_t);
+    }
+
+    /**
+     * \brief Informuje czy grupy odczytywane sa jadrem SSSE3
+     * \return Zwraca true, jesli wybrano jadro SSSE3
+     */
+    static bool usesSimd();
+
+private:
+    std::vector<uint64_t> starts; /**< Lista autora v to data[starts[v]..starts[v+1]) */
+    std::vector<uint8_t> data; /**< Zakodowane listy i PADDING zerowych bajtow */
+    uint32_t maxDegree; /**< Najwieksza liczba wspolpracownikow */
+    size_t entries; /**< Liczba zakodowanych wpisow */
+};
+
+#endif // COMPRESSEDADJACENCY_H
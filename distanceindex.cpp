@@ -0,0 +1,339 @@
+/**
+ * \file   distanceindex.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Indeks odleglosci pomiedzy parami autorow (pruned landmark labeling)
+ */
+
+#include "distanceindex.h"
+#include "parallel.h"
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <atomic>
+
+using namespace std;
+
+
+const int DistanceIndex::MAX_DISTANCE = 254;
+const uint32_t DistanceIndex::FILE_VERSION = 1;
+
+
+namespace
+{
+const uint8_t UNREACHED = 255; // znacznik autora nieodwiedzonego / wezla spoza etykiety
+const char INDEX_MAGIC[8] = {'E','R','D','O','S','P','L','L'}; // sygnatura pliku indeksu
+const uint32_t INDEX_ENDIANNESS = 0x01020304; // znacznik kolejnosci bajtow
+
+/**
+ * \brief Naglowek pliku indeksu. Polozenia sekcji liczone sa w bajtach od poczatku pliku
+ */
+struct IndexHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t endianness;
+    uint64_t nodeCount;
+    uint64_t graphEdges;
+    uint64_t entries;
+    uint64_t offsetsPos; // uint64_t[nodeCount+1]
+    uint64_t hubsPos; // uint32_t[entries]
+    uint64_t distancesPos; // uint8_t[entries]
+    uint64_t fileSize;
+};
+
+uint64_t align8(uint64_t pos)
+{
+    return (pos + 7) & ~uint64_t(7);
+}
+
+/**
+ * \brief Sprawdza czy wyrownana sekcja miesci sie w pliku
+ */
+bool sectionFits(uint64_t pos, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+{
+    return pos % 8 == 0 && pos <= fileSize && count <= (fileSize - pos) / elementSize;
+}
+
+/**
+ * \brief Pamiec robocza watku budujacego indeks
+ */
+struct Workspace
+{
+    vector<uint8_t> distance; // odleglosci od biezacego wezla (UNREACHED - nieodwiedzony)
+    vector<uint8_t> rootLabel; // etykieta biezacego wezla indeksowana ranga (UNREACHED - brak)
+    vector<AuthorsGraph::AuthorId> queue; // kolejka BFS
+};
+}
+
+
+DistanceIndex::DistanceIndex()
+{
+    clear();
+}
+
+void DistanceIndex::clear()
+{
+    nodeCount = 0;
+    graphEdges = 0;
+    entries = 0;
+    offsetsData.assign(1, 0);
+    hubsData.clear();
+    distancesData.clear();
+    file.reset();
+    attachOwnedData();
+}
+
+void DistanceIndex::attachOwnedData()
+{
+    offsets = offsetsData.data();
+    hubs = hubsData.data();
+    distances = distancesData.data();
+}
+
+bool DistanceIndex::build(AuthorsGraph &graph, int threads)
+{
+    typedef pair<uint32_t, uint8_t> Entry; // ranga wezla i odleglosc
+
+    clear();
+    graph.freezeCoAuthors();
+
+    int n = graph.getAuthorsCount();
+    JobProgress* progress = graph.getProgress();
+    threads = max(threads, 1);
+
+    vector<AuthorId> order(n); // wezly w kolejnosci malejacych stopni - ranga to pozycja w tej tablicy
+    for(int i = 0; i < n; ++i)
+        order[i] = i;
+
+    parallelSort(order.begin(), order.end(), [&graph](AuthorId a, AuthorId b)
+    {
+        return graph.getDegree(a) != graph.getDegree(b) ? graph.getDegree(a) > graph.getDegree(b) : a < b;
+    }, threads);
+
+    vector<vector<Entry>> labels(n);
+    vector<Workspace> workspaces(threads);
+    vector<vector<pair<AuthorId, uint8_t>>> found; // autorzy etykietowani przez kolejne wezly paczki
+    atomic<bool> tooDeep(false); // srednica grafu przekracza MAX_DISTANCE
+
+    for(auto& workspace: workspaces)
+    {
+        workspace.distance.assign(n, UNREACHED);
+        workspace.rootLabel.assign(n, UNREACHED);
+    }
+
+    for(uint32_t done = 0; done < (uint32_t)n && !tooDeep; )
+    {
+        //Paczki rosna wraz z postepem - pierwsze wezly (o najwiekszych stopniach) odcinaja najwiecej
+        uint32_t batch = threads == 1 ? 1 : min<uint32_t>(max<uint32_t>(done / 8, threads), threads * 256);
+        batch = min<uint32_t>(batch, n - done);
+        found.assign(batch, {});
+
+        parallelSlices(batch, min<uint32_t>(threads, batch), [&](uint64_t slice, uint64_t begin, uint64_t end)
+        {
+            Workspace& w = workspaces[slice];
+
+            for(uint64_t b = begin; b < end; ++b)
+            {
+                AuthorId root = order[done + b];
+
+                for(auto& entry: labels[root]) // etykieta wezla z wczesniejszych paczek
+                    w.rootLabel[entry.first] = entry.second;
+
+                w.queue.assign(1, root);
+                w.distance[root] = 0;
+
+                for(size_t head = 0; head < w.queue.size(); ++head)
+                {
+                    AuthorId a = w.queue[head];
+                    int d = w.distance[a];
+                    bool covered = false;
+
+                    for(auto& entry: labels[a]) // odleglosc wynika juz z etykiet - autor nie jest rozwijany
+                        if(w.rootLabel[entry.first] != UNREACHED && w.rootLabel[entry.first] + entry.second <= d)
+                        {
+                            covered = true;
+                            break;
+                        }
+
+                    if(covered)
+                        continue;
+
+                    found[b].emplace_back(a, d);
+
+                    if(d == MAX_DISTANCE)
+                    {
+                        tooDeep = true;
+                        continue;
+                    }
+
+                    const AuthorId* coAuthors = graph.getCoAuthors(a);
+                    for(uint32_t e = 0; e < graph.getDegree(a); ++e)
+                        if(w.distance[coAuthors[e]] == UNREACHED)
+                        {
+                            w.distance[coAuthors[e]] = d + 1;
+                            w.queue.push_back(coAuthors[e]);
+                        }
+                }
+
+                for(AuthorId a: w.queue)
+                    w.distance[a] = UNREACHED;
+                for(auto& entry: labels[root])
+                    w.rootLabel[entry.first] = UNREACHED;
+
+                if(progress)
+                    progress->report(w.queue.size(), 0);
+            }
+        });
+
+        for(uint32_t b = 0; b < batch; ++b) // dopisanie w kolejnosci rang - etykiety pozostaja posortowane
+            for(auto& item: found[b])
+                labels[item.first].emplace_back(done + b, item.second);
+
+        done += batch;
+
+        if(progress)
+        {
+            progress->setSteps(done, n);
+
+            if(progress->isCancelled())
+            {
+                clear();
+                return false;
+            }
+        }
+    }
+
+    if(tooDeep)
+    {
+        clear();
+        return false;
+    }
+
+    offsetsData.assign(n + 1, 0);
+    for(int i = 0; i < n; ++i)
+        offsetsData[i+1] = offsetsData[i] + labels[i].size();
+
+    hubsData.resize(offsetsData[n]);
+    distancesData.resize(offsetsData[n]);
+
+    parallelFor(n, 4096, threads, nullptr, [&](uint64_t begin, uint64_t end)
+    {
+        for(uint64_t i = begin; i < end; ++i)
+        {
+            uint64_t pos = offsetsData[i];
+
+            for(auto& entry: labels[i])
+            {
+                hubsData[pos] = entry.first;
+                distancesData[pos++] = entry.second;
+            }
+
+            vector<Entry>().swap(labels[i]);
+        }
+    });
+
+    nodeCount = n;
+    graphEdges = graph.getEdgesCount();
+    entries = offsetsData[n];
+    attachOwnedData();
+
+    return true;
+}
+
+int DistanceIndex::distance(AuthorId a, AuthorId b) const
+{
+    uint64_t i = offsets[a], iEnd = offsets[a+1];
+    uint64_t j = offsets[b], jEnd = offsets[b+1];
+    int best = AuthorsGraph::INFINITE_RANK;
+
+    while(i < iEnd && j < jEnd) // scalanie etykiet posortowanych wedlug rang wezlow
+    {
+        if(hubs[i] == hubs[j])
+        {
+            best = min(best, distances[i] + distances[j]);
+            ++i;
+            ++j;
+        }
+        else if(hubs[i] < hubs[j])
+            ++i;
+        else
+            ++j;
+    }
+
+    return best;
+}
+
+bool DistanceIndex::save(const string &path) const
+{
+    IndexHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = FILE_VERSION;
+    header.endianness = INDEX_ENDIANNESS;
+    header.nodeCount = nodeCount;
+    header.graphEdges = graphEdges;
+    header.entries = entries;
+    header.offsetsPos = align8(sizeof(header));
+    header.hubsPos = align8(header.offsetsPos + (header.nodeCount + 1) * sizeof(uint64_t));
+    header.distancesPos = align8(header.hubsPos + header.entries * sizeof(uint32_t));
+    header.fileSize = header.distancesPos + header.entries;
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if(!out)
+        return false;
+
+    auto writeSection = [&](uint64_t pos, const void* data, uint64_t bytes)
+    {
+        static const char padding[8] = {0};
+        out.write(padding, pos - out.tellp());
+        out.write(static_cast<const char*>(data), bytes);
+    };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeSection(header.offsetsPos, offsets, (header.nodeCount + 1) * sizeof(uint64_t));
+    writeSection(header.hubsPos, hubs, header.entries * sizeof(uint32_t));
+    writeSection(header.distancesPos, distances, header.entries);
+
+    return bool(out.flush());
+}
+
+bool DistanceIndex::load(const string &path, const AuthorsGraph &graph)
+{
+    IndexHeader header;
+    auto mapped = make_shared<MappedFile>();
+
+    if(!mapped->open(path) || mapped->size() < sizeof(header))
+        return false;
+
+    memcpy(&header, mapped->data(), sizeof(header));
+
+    //Weryfikacja naglowka, zgodnosci z grafem i polozenia sekcji - dane sekcji nie sa kopiowane ani przegladane
+    if(memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0 || header.version != FILE_VERSION ||
+       header.endianness != INDEX_ENDIANNESS || header.fileSize != mapped->size() ||
+       header.nodeCount != (uint64_t)graph.getAuthorsCount() || header.graphEdges != graph.getEdgesCount() ||
+       !sectionFits(header.offsetsPos, header.nodeCount + 1, sizeof(uint64_t), header.fileSize) ||
+       !sectionFits(header.hubsPos, header.entries, sizeof(uint32_t), header.fileSize) ||
+       !sectionFits(header.distancesPos, header.entries, 1, header.fileSize))
+        return false;
+
+    auto mappedOffsets = reinterpret_cast<const uint64_t*>(mapped->data() + header.offsetsPos);
+
+    if(mappedOffsets[header.nodeCount] != header.entries)
+        return false;
+
+    clear();
+
+    file = mapped;
+    nodeCount = header.nodeCount;
+    graphEdges = header.graphEdges;
+    entries = header.entries;
+    offsets = mappedOffsets;
+    hubs = reinterpret_cast<const uint32_t*>(mapped->data() + header.hubsPos);
+    distances = reinterpret_cast<const uint8_t*>(mapped->data() + header.distancesPos);
+
+    return true;
+}
@@ -0,0 +1,134 @@
+/**
+ * \file   distanceindex.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Indeks odleglosci pomiedzy parami autorow (pruned landmark labeling)
+ */
+
+#ifndef DISTANCEINDEX_H
+#define DISTANCEINDEX_H
+
+#include "authorsgraph.h"
+#include "mappedfile.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+/**
+ * \brief Indeks odleglosci zbudowany na zamrozonym grafie autorow (pruned landmark labeling).
+ *
+ * Kazdy autor otrzymuje etykiete: rosnaco posortowana liste par (ranga autora-wezla, odleglosc). Autorzy-wezly
+ * przetwarzani sa w kolejnosci malejacych stopni, a BFS z kolejnego wezla nie rozwija autorow, ktorych odleglosc
+ * wynika juz z wczesniejszych etykiet - dzieki temu etykiety sa krotkie. Odleglosc pary autorow to minimum sumy
+ * odleglosci po wspolnych wezlach obu etykiet (scalenie dwoch posortowanych tablic).
+ *
+ * Budowa jest rownolegla: wezly dzielone sa na paczki, a BFS wezlow paczki wykonywane sa jednoczesnie z odcinaniem
+ * wedlug etykiet wczesniejszych paczek. Etykiety sa wtedy nieco dluzsze, ale odleglosci pozostaja dokladne.
+ * Indeks mozna zapisac do pliku i odwzorowac z powrotem w pamieci (bez deserializacji); plik jest zwiazany
+ * z grafem, na ktorym go zbudowano. Odleglosci przechowywane sa na jednym bajcie - graf musi miec srednice
+ * nie wieksza niz MAX_DISTANCE.
+ */
+class DistanceIndex
+{
+public:
+    typedef AuthorsGraph::AuthorId AuthorId; /**< Identyfikator autora grafu */
+
+    static const int MAX_DISTANCE; /**< Najwieksza odleglosc zapisywana w etykiecie */
+    static const uint32_t FILE_VERSION; /**< Wersja formatu pliku indeksu */
+
+    /** Konstruktor pustego indeksu */
+    DistanceIndex();
+
+    DistanceIndex(const DistanceIndex&) = delete; // widoki wskazuja na wlasne dane indeksu
+    DistanceIndex& operator=(const DistanceIndex&) = delete;
+
+    /**
+     * \brief Buduje indeks dla grafu. Postep i przerwanie - przez zadanie, do ktorego przypiety jest graf
+     * \param graph Graf (zamrazany przed budowa, w trybie dwudzielnym rozwijane sa listy wspolpracownikow)
+     * \param threads Liczba watkow
+     * \return Zwraca false, jesli przerwano zadanie lub srednica grafu przekracza MAX_DISTANCE (indeks jest wtedy pusty)
+     */
+    bool build(AuthorsGraph& graph, int threads);
+
+    /**
+     * \brief Zwraca odleglosc pary autorow
+     * \param a Identyfikator pierwszego autora
+     * \param b Identyfikator drugiego autora
+     * \return Zwraca odleglosc lub AuthorsGraph::INFINITE_RANK, jesli autorzy nie sa polaczeni
+     */
+    int distance(AuthorId a, AuthorId b) const;
+
+    /**
+     * \brief Zapisuje indeks do pliku
+     * \param path Sciezka do pliku
+     * \return Zwraca true, jesli zapis sie powiodl
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * \brief Odwzorowuje plik indeksu w pamieci. Poprzednia zawartosc indeksu jest usuwana
+     * \param path Sciezka do pliku
+     * \param graph Graf, dla ktorego indeks ma byc uzywany - liczby autorow i krawedzi musza sie zgadzac
+     * \return Zwraca true, jesli plik jest poprawnym indeksem tego grafu
+     */
+    bool load(const std::string& path, const AuthorsGraph& graph);
+
+    /**
+     * \brief Usuwa indeks
+     */
+    void clear();
+
+    /**
+     * \brief Informuje czy indeks jest pusty
+     */
+    bool isEmpty() const
+    {
+        return nodeCount == 0;
+    }
+
+    /**
+     * \brief Zwraca liczbe autorow indeksu
+     */
+    int getAuthorsCount() const
+    {
+        return nodeCount;
+    }
+
+    /**
+     * \brief Zwraca laczna dlugosc etykiet (liczbe par wezel-odleglosc)
+     */
+    uint64_t getLabelEntries() const
+    {
+        return entries;
+    }
+
+    /**
+     * \brief Zwraca rozmiar indeksu w bajtach (poczatki etykiet, wezly i odleglosci)
+     */
+    uint64_t getBytes() const
+    {
+        return (uint64_t(nodeCount) + 1) * sizeof(uint64_t) + entries * (sizeof(uint32_t) + sizeof(uint8_t));
+    }
+
+private:
+    int nodeCount; /**< Liczba autorow */
+    uint64_t graphEdges; /**< Liczba krawedzi grafu, na ktorym zbudowano indeks */
+    uint64_t entries; /**< Laczna dlugosc etykiet */
+
+    std::vector<uint64_t> offsetsData; /**< Dane wlasne: etykieta autora i to pozycje [offsets[i], offsets[i+1]) */
+    std::vector<uint32_t> hubsData; /**< Dane wlasne: rangi wezlow etykiet (rosnaco w obrebie etykiety) */
+    std::vector<uint8_t> distancesData; /**< Dane wlasne: odleglosci od wezlow etykiet */
+    std::shared_ptr<MappedFile> file; /**< Odwzorowany plik indeksu (lub nullptr) */
+
+    const uint64_t* offsets; /**< Widok poczatkow etykiet */
+    const uint32_t* hubs; /**< Widok rang wezlow */
+    const uint8_t* distances; /**< Widok odleglosci */
+
+    /**
+     * \brief Ustawia widoki na dane wlasne indeksu
+     */
+    void attachOwnedData();
+};
+
+#endif // DISTANCEINDEX_H
@@ -0,0 +1,42 @@
+#-------------------------------------------------
+#
+# Model programu (graf, czytnik XML, pula scenariuszy, generator,
+# pomiary), wspolny dla aplikacji okienkowej, konsolowej i pomiarowej
+#
+#-------------------------------------------------
+
+CONFIG += c++17 thread
+QMAKE_CXXFLAGS_RELEASE += -O2
+
+INCLUDEPATH += $$PWD
+
+SOURCES += $$PWD/authorsgraph.cpp \
+    $$PWD/benchmark.cpp \
+    $$PWD/bitmap.cpp \
+    $$PWD/components.cpp \
+    $$PWD/compressedadjacency.cpp \
+    $$PWD/distanceindex.cpp \
+    $$PWD/generator.cpp \
+    $$PWD/mappedfile.cpp \
+    $$PWD/ranklist.cpp \
+    $$PWD/scenariosolver.cpp \
+    $$PWD/stringarena.cpp \
+    $$PWD/xmlscenarioreader.cpp
+
+HEADERS += $$PWD/authorsgraph.h \
+    $$PWD/benchmark.h \
+    $$PWD/bitmap.h \
+    $$PWD/bitops.h \
+    $$PWD/components.h \
+    $$PWD/compressedadjacency.h \
+    $$PWD/distanceindex.h \
+    $$PWD/generator.h \
+    $$PWD/jobprogress.h \
+    $$PWD/mappedfile.h \
+    $$PWD/parallel.h \
+    $$PWD/priorityqueues.h \
+    $$PWD/ranklist.h \
+    $$PWD/scenariosolver.h \
+    $$PWD/stringarena.h \
+    $$PWD/traversal.h \
+    $$PWD/xmlscenarioreader.h
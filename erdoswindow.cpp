@@ -9,13 +9,20 @@
 #include "erdoswindow.h"
 #include "ui_erdoswindow.h"
 #include "authorsgraph.h"
+#include "priorityqueues.h"
+#include "xmlscenarioreader.h"
+#include "scenariosolver.h"
+#include "generator.h"
+#include "ranktablemodel.h"
+#include "job.h"
 #include <QMessageBox>
-#include <QLayout>
-#include <QHBoxLayout>
+#include <QPushButton>
 #include <QTableWidget>
+#include <QTableView>
 #include <QFileDialog>
-#include <ctime>
-#include <cmath>
+#include <QFile>
+#include <QThread>
+#include <random>
 
 
 ErdosWindow::ErdosWindow(QWidget *parent) :
@@ -25,14 +32,40 @@ ErdosWindow::ErdosWindow(QWidget *parent) :
     //Wstepne przygotowanie elementow GUI
     ui->setupUi(this);
     ui->tableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->tableWidgetRandom->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    //Wyniki wyswietlane sa przez modele czytajace bezposrednio z list rang
+    xmlModel = new RankTableModel(this);
+    randomModel = new RankTableModel(this);
+
+    ui->xmlTableView->setModel(xmlModel);
+    ui->tableViewRandom->setModel(randomModel);
+
+    for(auto view: {ui->xmlTableView, ui->tableViewRandom})
+    {
+        view->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        view->setSortingEnabled(true);
+        view->sortByColumn(0, Qt::AscendingOrder);
+    }
 
     bar = new QProgressBar(ui->statusBar);
     ui->statusBar->addPermanentWidget(bar);
     bar->setVisible(false);
+
+    //Dlugotrwale operacje wykonywane sa w watku roboczym - okno pozostaje aktywne, a zadanie mozna przerwac
+    job = new Job(this);
+    cancelButton = new QPushButton("Anuluj", ui->statusBar);
+    ui->statusBar->addPermanentWidget(cancelButton);
+    cancelButton->setVisible(false);
+
+    connect(cancelButton, &QPushButton::clicked, job, &Job::cancel);
+    connect(job, &Job::progressChanged, this, &ErdosWindow::showJobProgress);
+    connect(job, &Job::finished, this, &ErdosWindow::jobFinished);
     ui->stackedWidget->setCurrentIndex(0);
     ui->algorithmButtonGroup->setId(ui->bfsButton,0);
     ui->algorithmButtonGroup->setId(ui->dijkstraButton,1);
+    ui->algorithmButtonGroup->setId(ui->doBfsButton,2);
+    ui->algorithmButtonGroup->setId(ui->parallelBfsButton,3);
+    ui->threadsSpinBox->setValue(QThread::idealThreadCount());
 
     ui->loadingButtonGroup->setId(ui->authorsPublicationsButton,0);
     ui->loadingButtonGroup->setId(ui->publicationsButton,1);
@@ -41,6 +74,10 @@ ErdosWindow::ErdosWindow(QWidget *parent) :
 
 ErdosWindow::~ErdosWindow()
 {
+    job->cancel(); // watek zadania moze korzystac z pol okna
+    job->wait();
+    xmlModel->clear(); // widoki nie moga odczytywac usuwanych wynikow
+    randomModel->clear();
     delete ui;
 }
 
@@ -52,7 +89,7 @@ void ErdosWindow::on_analyzeButton_clicked()
     int step = ui->stepSpinBox->value();
     int stepNo = ui->countSpinBox->value();
 
-    if (startCount + step*stepNo >3000)
+    if (checkedModel() == QUADRATIC && startCount + step*stepNo >3000)
     {
         QMessageBox::warning(this,"Ostrzeżenie", "Wykonanie analizy dla podanych parametrów może zająć więcej czasu");
     }
@@ -72,722 +109,734 @@ void ErdosWindow::on_analyzeButton_clicked()
 
     else if(ui->comboBox->currentIndex() == 1)// analiza szukania rangi
     {
-        Algorithm mode;
-
-        if(ui->algorithmButtonGroup->checkedId()==0)//analiza bfs
-            mode = BFS;
-        else//analiza dijkstra
-            mode = DIJKSTRA;
+        Algorithm mode = checkedAlgorithm();
 
         analyzeAlgorithm(startCount,step,stepNo, mode);
 
     }
 
+    else if(ui->comboBox->currentIndex() == 3) // skalowanie BFS rownoleglego
+    {
+        analyzeScaling(startCount, ui->threadsSpinBox->value());
+    }
+
+    else if(ui->comboBox->currentIndex() == 4) // porownanie kolejek Dijkstry
+    {
+        analyzeQueues(startCount);
+    }
+
+    else if(ui->comboBox->currentIndex() == 5) // BFS wielozrodlowy
+    {
+        analyzeMultiSource(startCount);
+    }
+
     else // pelna analiza
     {
         Loading loadMode;
-        Algorithm algMode;
+        Algorithm algMode = checkedAlgorithm();
 
         if(ui->loadingButtonGroup->checkedId()==0) //pelne ladowanie
             loadMode = FULL;
         else //ladowanie po publikacjach
             loadMode = PUBLICATIONSONLY;
 
-        if(ui->algorithmButtonGroup->checkedId()==0)//analiza bfs
-            algMode = BFS;
-        else//analiza dijkstra
-            algMode = DIJKSTRA;
-
         fullAnalisis(startCount,step,stepNo,loadMode,algMode);
 
     }
 
 }
 
-int ErdosWindow::generateInput(int n, std::vector<std::string> &authors, std::vector<std::vector<std::string>>& publications)
+namespace
 {
-    int edgeCounter = 0;//licznik krawedzi
-    int n1;
-    set<int> nodes;
-
-    if (n<10)
-        return 0;
-
-    authors.clear();
-    publications.clear();
-
-    authors.push_back("Erdos"); //Dodanie Erdosa
-
-    for (int i = 1; i<n; ++i) //Tworzenie autorow
-        authors.push_back(to_string(i));
+/**
+ * \brief Zwraca losowe ziarno generatora danych
+ */
+uint64_t randomSeed()
+{
+    random_device device;
+    return (uint64_t)device() << 32 | device();
+}
+}
 
-    for(int i = n-1; i>0; --i) //Losowa generacja okolo n*(n-1)/4 krawedzi
+ErdosWindow::Algorithm ErdosWindow::checkedAlgorithm() const
+{
+    switch(ui->algorithmButtonGroup->checkedId())
     {
-        if(i == 1)
-        {
-            publications.push_back(vector<string>()={to_string(i),"Erdos"});
-            ++edgeCounter;
-        }
-        else if(i == 2)
-        {
-            n1 = rand() % i;
-            if(n1 == 0)
-                publications.push_back(vector<string>()={to_string(i),"Erdos"});
-            else
-                publications.push_back(vector<string>()={to_string(i),to_string(n1)});
-
-            ++edgeCounter;
-        }
-
-        else
-        {
-            nodes.clear();
+    case 1:
+        return DIJKSTRA;
+    case 2:
+        return DOBFS;
+    case 3:
+        return PARALLELBFS;
+    default:
+        return BFS;
+    }
+}
 
-            for(int j=0; j< i/2; ++j)
-            {
-                do
-                {
-                    n1 = rand() % i;
-                }while(nodes.insert(n1).second != true);
+AuthorsGraph::RankList * ErdosWindow::getRanks(AuthorsGraph &graph, Algorithm algorithm, int threadCount)
+{
+    return graph.getRanks(algorithmName(algorithm), threadCount);
+}
 
-                ++edgeCounter;
-            }
+string ErdosWindow::algorithmName(Algorithm algorithm)
+{
+    switch(algorithm)
+    {
+    case DIJKSTRA:
+        return "dijkstra";
+    case DOBFS:
+        return "dobfs";
+    case PARALLELBFS:
+        return "parallel";
+    default:
+        return "bfs";
+    }
+}
 
-            for(auto node: nodes)
-            {
-                if(node == 0)
-                    publications.push_back(vector<string>()={to_string(i),"Erdos"});
-                else
-                    publications.push_back(vector<string>()={to_string(i),to_string(node)});
-            }
-        }
+QString ErdosWindow::algorithmTitle(Algorithm algorithm)
+{
+    switch(algorithm)
+    {
+    case DIJKSTRA:
+        return "Dijkstra";
+    case DOBFS:
+        return "BFS hybrydowy";
+    case PARALLELBFS:
+        return "BFS równoległy";
+    default:
+        return "BFS";
     }
+}
 
-    return edgeCounter;
+Benchmark ErdosWindow::createBenchmark() const
+{
+    return Benchmark(ui->warmupSpinBox->value(), ui->repetitionsSpinBox->value());
 }
 
-void ErdosWindow::analyzeLoading (int startCount, int step, int stepNo, Loading loadMode)
+GraphModel ErdosWindow::checkedModel() const
 {
-    QTableWidgetItem * newItem;
-    vector<double> times;
-    vector<int> edgeCounter;
-    double medianTime;//t(n) mediany
-    double medianTheory; //T(n) mediany
-    double q;
+    switch(ui->modelComboBox->currentIndex())
+    {
+    case 1:
+        return PREFERENTIAL_ATTACHMENT;
+    case 2:
+        return RMAT;
+    case 3:
+        return TEAMS;
+    default:
+        return QUADRATIC;
+    }
+}
 
-    AuthorsGraph graph;
-    vector<string> authors;
-    vector<vector<string>> publications;
+GeneratorParams ErdosWindow::generatorParams(int n) const
+{
+    GeneratorParams params;
 
-    bar->setVisible(true); //pokaz pasek ladowania
-    bar->setValue(0);
-    ui->statusBar->showMessage("Trwa analiza",0);
+    params.model = checkedModel();
+    params.authors = n;
+    params.seed = randomSeed();
+    params.threads = ui->threadsSpinBox->value();
 
-    //Obliczanie czasow analizy
-    for(int i = 0 ;i<stepNo;++i)
-    {
-        clock_t t;
-        int a = generateInput(startCount + i*step,authors,publications);
-        edgeCounter.push_back(a);
+    return params;
+}
 
-        if(loadMode == FULL)
-        {
-            t = clock();
-            graph.loadGraph(authors,publications);
-            t = clock() - t;
-        }
-        else
-        {
-            t = clock();
-            graph.loadGraph(publications);
-            t = clock() - t;
-        }
-        times.push_back(1000*((double)t)/CLOCKS_PER_SEC);
-        bar->setValue(100*i/stepNo);
-    }
+int ErdosWindow::generateGraph(GeneratorParams params, bool bipartite, AuthorsGraph &graph)
+{
+    params.progress = graph.getProgress();
+    graph.setBipartite(bipartite);
+    graph.setBuildThreads(params.threads);
 
-    //Wyznaczanie mediany probek
-    if(stepNo%2 ==0)
+    if(params.model == QUADRATIC) // ladowanie po publikacjach, jak w analizie algorytmow
     {
-        int m1 = stepNo/2;
-        int m2 = m1-1;
-        medianTime = (times[m1] + times[m2])/2;
-        medianTheory = (edgeCounter[m1] * log2(startCount+m1*step) + edgeCounter[m2] * log2(startCount+m2*step))/2;
-    }
+        Authors authors;
+        Publications publications;
 
-    else
-    {
-        int median = stepNo/2;
-        medianTime = times[median];
-        medianTheory = edgeCounter[median] * log2(startCount+median*step);
+        generateInput(params.authors, authors, publications, params.seed);
+        graph.loadGraph(publications);
     }
-
-    //obliczanie wyświetlanie wyników
-    ui->tableWidget->clearContents();
-    ui->tableWidget->setRowCount(stepNo);
-    if(loadMode == FULL)
-        ui->analisisTypeLabel->setText("Pełne Ładowanie");
     else
-        ui->analisisTypeLabel->setText("Ładowanie Publikacji");
-
-    ui->complexityLabel->setText("v log(n)");
-
-    //Obliczanie q i wyswietlanie n,v,t(n) i q
-    for(int i =0; i<stepNo; ++i)
     {
-        q = times[i] / (edgeCounter[i] * log2(startCount+i*step)) *medianTheory / medianTime;
+        SyntheticPublications publications;
 
-        newItem = new QTableWidgetItem(QString::number(startCount+i*step)); // wyswietlanie liczby wezlow
-        ui->tableWidget->setItem(i, 0, newItem);
+        generatePublications(params, publications);
+        loadSynthetic(publications, graph);
+    }
 
-        newItem = new QTableWidgetItem(QString::number(edgeCounter[i])); // wyswietlanie liczby krawedzi
-        ui->tableWidget->setItem(i, 1, newItem);
+    return graph.getEdgesCount();
+}
 
-        newItem = new QTableWidgetItem(QString::number(times[i],'f',0)); // wyswietlanie czasu
-        ui->tableWidget->setItem(i, 2, newItem);
+void ErdosWindow::analyzeLoading (int startCount, int step, int stepNo, Loading loadMode)
+{
+    BenchmarkPlan plan;
 
-        newItem = new QTableWidgetItem(QString::number(q,'f',3)); // wyswietlanie q
-        ui->tableWidget->setItem(i, 3, newItem);
-    }
+    plan.startCount = startCount;
+    plan.step = step;
+    plan.stepNo = stepNo;
+    plan.generator = generatorParams(startCount);
+    plan.publicationsOnly = loadMode == PUBLICATIONSONLY;
+    plan.bipartite = ui->bipartiteCheckBox->isChecked();
 
-    ui->statusBar->clearMessage();
-    bar->setVisible(false);
-    ui->stackedWidget->setCurrentIndex(1);
-    ui->tableWidget->horizontalHeader()->setVisible(true);
+    showBenchmark(plan, loadMode == FULL ? "Pełne Ładowanie" : "Ładowanie Publikacji", "v log(n)");
 }
 
 void ErdosWindow::analyzeAlgorithm (int startCount, int step, int stepNo, Algorithm algorithm)
 {
-    QTableWidgetItem * newItem;
-    vector<double> times;
-    vector<int> edgeCounter;
-    double medianTime; //medianowe t(n)
-    double medianTheory; //medianowe T(n)
-    double q;
+    BenchmarkPlan plan;
+    int threads = ui->threadsSpinBox->value();
+
+    plan.startCount = startCount;
+    plan.step = step;
+    plan.stepNo = stepNo;
+    plan.generator = generatorParams(startCount);
+    plan.publicationsOnly = true;
+    plan.bipartite = ui->bipartiteCheckBox->isChecked();
+    plan.measureLoading = false;
+    plan.algorithm = algorithmName(algorithm);
+    plan.solve = [algorithm, threads](AuthorsGraph& graph) { return getRanks(graph, algorithm, threads); };
+    plan.rankComplexity = algorithm == DIJKSTRA ? Benchmark::logLinear : Benchmark::linear;
+
+    showBenchmark(plan, algorithmTitle(algorithm), algorithm == DIJKSTRA ? "v log(n)" : "v + n");
+}
 
-    AuthorsGraph graph;
-    vector<string> authors;
-    vector<vector<string>> publications;
+void ErdosWindow::fullAnalisis (int startCount, int step, int stepNo, Loading loadMode, Algorithm algorithm)
+{
+    BenchmarkPlan plan;
+    int threads = ui->threadsSpinBox->value();
+
+    plan.startCount = startCount;
+    plan.step = step;
+    plan.stepNo = stepNo;
+    plan.generator = generatorParams(startCount);
+    plan.publicationsOnly = loadMode == PUBLICATIONSONLY;
+    plan.bipartite = ui->bipartiteCheckBox->isChecked();
+    plan.algorithm = algorithmName(algorithm);
+    plan.solve = [algorithm, threads](AuthorsGraph& graph) { return getRanks(graph, algorithm, threads); };
+    plan.rankComplexity = algorithm == DIJKSTRA ? Benchmark::logLinear : Benchmark::linear;
+
+    //Ladowanie i wyznaczanie rang mierzone sa osobno - kazda faza ma wlasny wspolczynnik q
+    showBenchmark(plan, (loadMode == FULL ? "Pełne Ładowanie + " : "Ładowanie publikacji + ") + algorithmTitle(algorithm),
+                  algorithm == DIJKSTRA ? "ładowanie: v log(n), rangi: v log(n)" : "ładowanie: v log(n), rangi: v + n");
+}
 
-    bar->setVisible(true);
-    bar->setValue(0);
-    ui->statusBar->showMessage("Trwa analiza",0);
+void ErdosWindow::showBenchmark(const BenchmarkPlan &plan, const QString &title, const QString &complexity)
+{
+    Benchmark benchmark = createBenchmark();
+    auto rows = make_shared<vector<BenchmarkRow>>();
 
-    //Obliczanie czasow analizy
-    for(int i = 0 ;i<stepNo;++i)
+    startJob("Trwa analiza", [benchmark, plan, rows](JobProgress& progress)
     {
-        clock_t t;
-        int a = generateInput(startCount + i*step,authors,publications);
-        edgeCounter.push_back(a);
-        graph.loadGraph(publications);
-
-        if(algorithm == BFS)
-        {
-            t = clock();
-            auto result = graph.getRanksBFS();
-            t = clock() - t;
-            delete result;
-        }
-        else
-        {
-            t = clock();
-            auto result = graph.getRanksDijkstry();
-            t = clock() - t;
-            delete result;
-        }
-        times.push_back(1000*((double)t)/CLOCKS_PER_SEC);
-        bar->setValue(100*i/stepNo);
-    }
-
-    //Wyznaczanie mediany
-    if(stepNo%2 ==0)
+        BenchmarkPlan jobPlan = plan;
+        jobPlan.progress = &progress;
+        *rows = benchmark.run(jobPlan);
+    },
+    [this, rows, title, complexity](bool cancelled)
     {
-        int m1 = stepNo/2;
-        int m2 = m1-1;
-        medianTime = (times[m1] + times[m2])/2;
-
-        if(algorithm == BFS)
-            medianTheory = (startCount+m1*step + edgeCounter[m1] + startCount+m2*step + edgeCounter[m2])/2;
-        else
-            medianTheory = (edgeCounter[m1] * log2(startCount+m1*step) + edgeCounter[m2] * log2(startCount+m2*step))/2;
-    }
+        QTableWidgetItem * newItem;
+        QStringList labels;
 
-    else
-    {
-        int median = stepNo/2;
-        medianTime = times[median];
+        if(cancelled)
+            return;
 
-        if(algorithm == BFS)
-            medianTheory = startCount+median*step + edgeCounter[median];
-        else
-            medianTheory = edgeCounter[median] * log2(startCount+median*step);
-    }
+        labels<<"Liczba węzłów (n)"<<"Liczba krawędzi (v)"<<"Faza"<<"t mediana [ms]"<<"t p95 [ms]"<<"95% CI średniej [ms]"<<"q(n)";
 
-    //wyświetlanie wyników
-    ui->tableWidget->clearContents();
-    ui->tableWidget->setRowCount(stepNo);
+        //wyświetlanie wyników
+        ui->tableWidget->clearContents();
+        ui->tableWidget->setColumnCount(labels.size());
+        ui->tableWidget->setRowCount(rows->size());
+        ui->tableWidget->setHorizontalHeaderLabels(labels);
+        ui->analisisTypeLabel->setText(title);
+        ui->complexityLabel->setText(complexity);
 
-    if(algorithm == BFS)
-    {
-        ui->analisisTypeLabel->setText("BFS");
-        ui->complexityLabel->setText("v + n");
-    }
-    else
-    {
-        ui->analisisTypeLabel->setText("Dijkstra");
-        ui->complexityLabel->setText("v log(n)");
-    }
+        for(unsigned int i = 0; i < rows->size(); ++i)
+        {
+            const BenchmarkRow& row = (*rows)[i];
+            const BenchmarkStats& stats = row.stats;
 
+            newItem = new QTableWidgetItem(QString::number(row.authors)); // liczba wezlow
+            ui->tableWidget->setItem(i, 0, newItem);
 
-    //Obliczanie q oraz wyswietlanie n,v,t(n),q
-    for(int i =0; i<stepNo; ++i)
-    {
-        if(algorithm == BFS)
-            q = times[i]/(edgeCounter[i] + startCount + i*step) *medianTheory / medianTime;
-        else
-            q = times[i] / (edgeCounter[i] * log2(startCount+i*step)) *medianTheory / medianTime;
+            newItem = new QTableWidgetItem(QString::number(row.edges)); // liczba krawedzi
+            ui->tableWidget->setItem(i, 1, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(startCount+i*step)); // wyswietlanie liczby wezlow
-        ui->tableWidget->setItem(i, 0, newItem);
+            newItem = new QTableWidgetItem(row.phase == "load" ? "ładowanie" : "rangi"); // faza
+            ui->tableWidget->setItem(i, 2, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(edgeCounter[i])); // wyswietlanie liczby krawedzi
-        ui->tableWidget->setItem(i, 1, newItem);
+            newItem = new QTableWidgetItem(QString::number(stats.median,'f',2)); // mediana powtorzen
+            ui->tableWidget->setItem(i, 3, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(times[i],'f',0)); // wyswietlanie czasu
-        ui->tableWidget->setItem(i, 2, newItem);
+            newItem = new QTableWidgetItem(QString::number(stats.p95,'f',2)); // 95. percentyl
+            ui->tableWidget->setItem(i, 4, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(q,'f',3)); // wyswietlanie q
-        ui->tableWidget->setItem(i, 3, newItem);
-    }
+            newItem = new QTableWidgetItem(QString::number(stats.ciLow,'f',2) + " – " + QString::number(stats.ciHigh,'f',2));
+            ui->tableWidget->setItem(i, 5, newItem);
 
-    ui->statusBar->clearMessage();
-    bar->setVisible(false);
-    ui->stackedWidget->setCurrentIndex(1);
-    ui->tableWidget->horizontalHeader()->setVisible(true);
+            newItem = new QTableWidgetItem(QString::number(row.q,'f',3)); // wyswietlanie q
+            ui->tableWidget->setItem(i, 6, newItem);
+        }
+
+        ui->stackedWidget->setCurrentIndex(1);
+        ui->tableWidget->horizontalHeader()->setVisible(true);
+    });
 }
 
-void ErdosWindow::fullAnalisis (int startCount, int step, int stepNo, Loading loadMode, Algorithm algorithm)
+void ErdosWindow::analyzeScaling(int n, int maxThreads)
 {
-    QTableWidgetItem * newItem;
-    vector<double> times;
-    vector<int> edgeCounter;
-    double medianTime;
-    double medianTheory;
-    double q;
-
-    AuthorsGraph graph;
-    vector<string> authors;
-    vector<vector<string>> publications;
-
-    bar->setVisible(true);
-    bar->setValue(0);
-    ui->statusBar->showMessage("Trwa analiza",0);
+    Benchmark benchmark = createBenchmark();
+    GeneratorParams params = generatorParams(n);
+    bool bipartite = ui->bipartiteCheckBox->isChecked();
+    auto times = make_shared<vector<double>>();
+    auto edges = make_shared<int>(0);
 
-    //Obliczanie czasow analizy
-    for(int i = 0 ;i<stepNo;++i)
+    startJob("Trwa analiza", [benchmark, params, bipartite, maxThreads, times, edges](JobProgress& progress)
     {
-        clock_t t;
-        int a = generateInput(startCount + i*step,authors,publications);
-        edgeCounter.push_back(a);
+        AuthorsGraph graph;
 
-        t = clock();
-        if(loadMode == FULL)
-            graph.loadGraph(authors,publications);
-        else
-            graph.loadGraph(publications);
+        graph.setProgress(&progress);
+        *edges = generateGraph(params, bipartite, graph);
 
-        if(algorithm ==BFS)
+        //Pomiar czasu rzeczywistego - clock() sumowalby czas procesora wszystkich watkow
+        for(int threads = 1; threads <= maxThreads && !progress.isCancelled(); ++threads)
         {
-            auto result = graph.getRanksBFS();
-            delete result;
+            progress.setSteps(threads - 1, maxThreads);
+            times->push_back(benchmark.measure([&]{ delete graph.getRanksParallelBFS(threads); }).median);
         }
-        else
-        {
-            auto result = graph.getRanksDijkstry();
-            delete result;
-        }
-
-        t = clock() - t;
-        times.push_back(1000*((double)t)/CLOCKS_PER_SEC);
-        bar->setValue(100*i/stepNo);
-    }
-
-    //Wyznaczanie mediany
-    if(stepNo%2 ==0)
+    },
+    [this, n, times, edges](bool cancelled)
     {
-        int m1 = stepNo/2;
-        int m2 = m1-1;
-        medianTime = (times[m1] + times[m2])/2;
-        medianTheory = (edgeCounter[m1] * log2(startCount+m1*step) + edgeCounter[m2] * log2(startCount+m2*step))/2;
-    }
+        QTableWidgetItem * newItem;
+        QStringList labels;
 
-    else
-    {
-        int median = stepNo/2;
-        medianTime = times[median];
-        medianTheory = edgeCounter[median] * log2(startCount+median*step);
-    }
+        if(cancelled)
+            return;
 
-    //wyświetlanie wyników
-    ui->tableWidget->clearContents();
-    ui->tableWidget->setRowCount(stepNo);
+        labels<<"Liczba wątków"<<"Liczba krawędzi (v)"<<"t mediana [ms]"<<"Przyspieszenie";
 
+        //wyświetlanie wyników
+        ui->tableWidget->clearContents();
+        ui->tableWidget->setColumnCount(labels.size());
+        ui->tableWidget->setRowCount(times->size());
+        ui->tableWidget->setHorizontalHeaderLabels(labels);
+        ui->analisisTypeLabel->setText("Skalowanie BFS równoległego, n = " + QString::number(n));
+        ui->complexityLabel->setText("(v + n) / p");
 
-    if(loadMode == FULL)
-    {
-        if(algorithm == BFS)
-            ui->analisisTypeLabel->setText("Pełne Ładowanie + BFS");
-        else
-           ui->analisisTypeLabel->setText("Pełne Ładowanie + Dijkstra");
-    }
-
-    else
-    {
-        if(algorithm == BFS)
-            ui->analisisTypeLabel->setText("Ładowanie publikacji + BFS");
-        else
-           ui->analisisTypeLabel->setText("Ładowanie publikacji + Dijkstra");
-    }
-
-    ui->complexityLabel->setText("v log(n)");
-
-    //Obliczanie q oraz wyswietlanie n,v,t(n),q
-    for(int i =0; i<stepNo; ++i)
-    {
-        q = times[i] / (edgeCounter[i] * log2(startCount+i*step)) *medianTheory / medianTime;
-
-        newItem = new QTableWidgetItem(QString::number(startCount+i*step)); // wyswietlanie liczby wezlow
-        ui->tableWidget->setItem(i, 0, newItem);
+        for(unsigned int i = 0; i < times->size(); ++i)
+        {
+            newItem = new QTableWidgetItem(QString::number(i+1)); // liczba watkow
+            ui->tableWidget->setItem(i, 0, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(edgeCounter[i])); // wyswietlanie liczby krawedzi
-        ui->tableWidget->setItem(i, 1, newItem);
+            newItem = new QTableWidgetItem(QString::number(*edges)); // liczba krawedzi
+            ui->tableWidget->setItem(i, 1, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(times[i],'f',0)); // wyswietlanie czasu
-        ui->tableWidget->setItem(i, 2, newItem);
+            newItem = new QTableWidgetItem(QString::number((*times)[i],'f',2)); // czas
+            ui->tableWidget->setItem(i, 2, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(q,'f',3)); // wyswietlanie q
-        ui->tableWidget->setItem(i, 3, newItem);
-    }
+            newItem = new QTableWidgetItem(QString::number((*times)[0]/(*times)[i],'f',2)); // przyspieszenie wzgledem 1 watku
+            ui->tableWidget->setItem(i, 3, newItem);
+        }
 
-    ui->statusBar->clearMessage();
-    bar->setVisible(false);
-    ui->stackedWidget->setCurrentIndex(1);
-    ui->tableWidget->horizontalHeader()->setVisible(true);
+        ui->stackedWidget->setCurrentIndex(1);
+        ui->tableWidget->horizontalHeader()->setVisible(true);
+    });
 }
 
-void ErdosWindow::getXMLSolution()
+void ErdosWindow::analyzeQueues(int n)
 {
-    AuthorsGraph graph;
-    vector<pair<string,int>> * result = nullptr;
-    QHBoxLayout *layout;
-    QTableWidget* table;
-    QWidget *page;
-    QStringList labels;
-    QTableWidgetItem* newItem;
-    int scenarioCount = scenarios.size();
-    int i =1;
+    Benchmark benchmark = createBenchmark();
+    GeneratorParams params = generatorParams(n);
+    bool bipartite = ui->bipartiteCheckBox->isChecked();
+    auto times = make_shared<vector<double>>();
+    auto edges = make_shared<int>(0);
 
-    labels<<"Nazwisko"<<"Ranga";
-
-    if(scenarioCount==0)
-        return;
-
-    ui->xmlTabWidget->clear();
-    for(auto scenario: scenarios)
+    startJob("Trwa analiza", [benchmark, params, bipartite, times, edges](JobProgress& progress)
     {
-        if(ui->loadingButtonGroup->checkedId()==0) //pelne ladowanie
-            graph.loadGraph(scenario.first,scenario.second);
-        else //ladowanie po publikacjach
-            graph.loadGraph(scenario.second);
-
-        if(ui->algorithmButtonGroup->checkedId()==0)//bfs
-            result = graph.getRanksBFS();
-        else//dijkstra
-            result = graph.getRanksDijkstry();
-
-        //wyswietlanie wynikow
-        layout = new QHBoxLayout();
-        table = new QTableWidget();
-        table->setRowCount(result->size());
-        table->setColumnCount(2);
-        table->setHorizontalHeaderLabels(labels);
-        table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-        layout->addWidget(table);
-        page = new QWidget();
-        page->setLayout(layout);
-        ui->xmlTabWidget->addTab(page,"Scenariusz "+QString::number(i));
-        ++i;
-
-        for(unsigned int j =0; j<result->size();++j)
+        AuthorsGraph graph;
+        vector<function<AuthorsGraph::RankList*()>> queues = {
+            [&]{ return graph.getRanksDijkstry(); },
+            [&]{ return graph.getRanksDijkstry<BucketQueue>(); },
+            [&]{ return graph.getRanksDijkstry<RadixHeap>(); },
+            [&]{ return graph.getRanksDijkstry<DAryHeap<4>>(); },
+            [&]{ return graph.getRanksDijkstry<PairingHeap>(); }
+        };
+
+        graph.setProgress(&progress);
+        *edges = generateGraph(params, bipartite, graph);
+
+        for(size_t i = 0; i < queues.size() && !progress.isCancelled(); ++i)
         {
-            newItem = new QTableWidgetItem(QString::fromStdString(result->at(j).first)); // wyswietlanie liczby wezlow
-            table->setItem(j, 0, newItem);
-
-            newItem = new QTableWidgetItem(QString::number(result->at(j).second)); // wyswietlanie liczby krawedzi
-            table->setItem(j, 1, newItem);
+            progress.setSteps(i, queues.size());
+            times->push_back(benchmark.measure([&]{ delete queues[i](); }).median);
         }
+    },
+    [this, n, times, edges](bool cancelled)
+    {
+        QTableWidgetItem * newItem;
+        QStringList labels;
+        QStringList queues;
+
+        if(cancelled)
+            return;
+
+        labels<<"Kolejka"<<"Liczba krawędzi (v)"<<"t mediana [ms]"<<"Przyspieszenie";
+        queues<<"std::set (obecna)"<<QString::fromUtf8(BucketQueue::name())<<QString::fromUtf8(RadixHeap::name())
+              <<QString::fromUtf8(DAryHeap<4>::name())<<QString::fromUtf8(PairingHeap::name());
+
+        //wyświetlanie wyników
+        ui->tableWidget->clearContents();
+        ui->tableWidget->setColumnCount(labels.size());
+        ui->tableWidget->setRowCount(times->size());
+        ui->tableWidget->setHorizontalHeaderLabels(labels);
+        ui->analisisTypeLabel->setText("Kolejki Dijkstry, n = " + QString::number(n));
+        ui->complexityLabel->setText("v log(n)");
 
-    }
+        for(unsigned int i = 0; i < times->size(); ++i)
+        {
+            newItem = new QTableWidgetItem(queues[i]); // nazwa kolejki
+            ui->tableWidget->setItem(i, 0, newItem);
 
-    if(result != nullptr)
-        delete result;
+            newItem = new QTableWidgetItem(QString::number(*edges)); // liczba krawedzi
+            ui->tableWidget->setItem(i, 1, newItem);
 
-    ui->stackedWidget->setCurrentIndex(3);
+            newItem = new QTableWidgetItem(QString::number((*times)[i],'f',2)); // czas
+            ui->tableWidget->setItem(i, 2, newItem);
+
+            newItem = new QTableWidgetItem(QString::number((*times)[0]/(*times)[i],'f',2)); // przyspieszenie wzgledem std::set
+            ui->tableWidget->setItem(i, 3, newItem);
+        }
 
+        ui->stackedWidget->setCurrentIndex(1);
+        ui->tableWidget->horizontalHeader()->setVisible(true);
+    });
 }
 
-void ErdosWindow::getRandomSolution()
+void ErdosWindow::analyzeMultiSource(int n)
 {
-    AuthorsGraph graph;
-    Authors authors;
-    Publications publications;
-    vector<pair<string,int>> * result;
-    QTableWidgetItem *newItem;
-    QTreeWidgetItem *root;
-    QTreeWidgetItem *authorsRoot;
-    QTreeWidgetItem *publicationsRoot;
-    QTreeWidgetItem *publicationRoot;
-    int size = ui->randomSizeSpinBox->value();
+    Benchmark benchmark = createBenchmark();
+    GeneratorParams params = generatorParams(n);
+    bool bipartite = ui->bipartiteCheckBox->isChecked();
+    auto counts = make_shared<vector<size_t>>();
+    auto separateTimes = make_shared<vector<double>>();
+    auto multiTimes = make_shared<vector<double>>();
+
+    startJob("Trwa analiza", [benchmark, params, bipartite, counts, separateTimes, multiTimes](JobProgress& progress)
+    {
+        AuthorsGraph graph;
+        vector<AuthorsGraph::AuthorId> roots;
 
-    generateInput(size,authors,publications);
+        graph.setProgress(&progress);
+        generateGraph(params, bipartite, graph);
 
-    if(ui->loadingButtonGroup->checkedId()==0) //pelne ladowanie
-        graph.loadGraph(authors,publications);
-    else //ladowanie po publikacjach
-        graph.loadGraph(publications);
+        for(size_t count = 64; count <= AuthorsGraph::MULTI_SOURCE_WIDTH && count <= (size_t)graph.getAuthorsCount(); count *= 2)
+            counts->push_back(count);
 
-    if(ui->algorithmButtonGroup->checkedId()==0)//bfs
-        result = graph.getRanksBFS();
-    else//dijkstra
-        result = graph.getRanksDijkstry();
-
-    //Wyswietlanie struktury wylosowanych danych
-    ui->treeWidget->clear();
-    root = new QTreeWidgetItem(ui->treeWidget);
-    root->setText(0,"Scenariusz");
-    ui->treeWidget->addTopLevelItem(root);
+        for(unsigned int i = 0; i < counts->size() && !progress.isCancelled(); ++i)
+        {
+            progress.setSteps(i, counts->size());
 
-    authorsRoot = new QTreeWidgetItem();
-    authorsRoot->setText(0,"Autorzy");
-    root->addChild(authorsRoot);
+            roots.clear();
+            for(AuthorsGraph::AuthorId id = 0; roots.size() < (*counts)[i]; ++id) // zrodlami sa pierwsi autorzy grafu
+                roots.push_back(id);
 
-    publicationsRoot = new QTreeWidgetItem();
-    publicationsRoot->setText(0,"Publikacje");
-    root->addChild(publicationsRoot);
+            separateTimes->push_back(benchmark.measure([&]
+            {
+                for(auto root: roots)
+                    delete graph.getDistancesBFS(root);
+            }).median);
+            multiTimes->push_back(benchmark.measure([&]{ delete graph.getDistancesMultiSourceBFS(roots); }).median);
+        }
+    },
+    [this, n, counts, separateTimes, multiTimes](bool cancelled)
+    {
+        QTableWidgetItem * newItem;
+        QStringList labels;
 
-    //dodawanie autorów
+        if(cancelled)
+            return;
 
-    for(auto author: authors)
-    {
-        QTreeWidgetItem * authorItem = new QTreeWidgetItem();
-        authorItem->setText(0,QString::fromStdString(author));
-        authorsRoot->addChild(authorItem);
-    }
+        labels<<"Liczba źródeł"<<"t BFS osobno, mediana [ms]"<<"t MS-BFS, mediana [ms]"<<"Przyspieszenie";
 
-    int j = 1;
-    for(auto publication: publications) //dodawanie publikacji
-    {
-        publicationRoot = new QTreeWidgetItem();
-        publicationRoot->setText(0,"Publikacja "+ QString::number(j));
-        publicationsRoot->addChild(publicationRoot);
+        //wyświetlanie wyników
+        ui->tableWidget->clearContents();
+        ui->tableWidget->setColumnCount(labels.size());
+        ui->tableWidget->setRowCount(multiTimes->size());
+        ui->tableWidget->setHorizontalHeaderLabels(labels);
+        ui->analisisTypeLabel->setText("BFS wieloźródłowy, n = " + QString::number(n));
+        ui->complexityLabel->setText("(v + n) * k / 64");
 
-        for(auto author: publication)
+        for(unsigned int i = 0; i < multiTimes->size(); ++i)
         {
-            QTreeWidgetItem * authorItem = new QTreeWidgetItem();
-            authorItem->setText(0,QString::fromStdString(author));
-            publicationRoot->addChild(authorItem);
-        }
-        ++j;
-    }
-
+            newItem = new QTableWidgetItem(QString::number((*counts)[i])); // liczba zrodel
+            ui->tableWidget->setItem(i, 0, newItem);
 
-    ui->tableWidgetRandom->clearContents();
-    ui->tableWidgetRandom->setRowCount(result->size());
+            newItem = new QTableWidgetItem(QString::number((*separateTimes)[i],'f',2)); // czas osobnych przebiegow
+            ui->tableWidget->setItem(i, 1, newItem);
 
-    for(unsigned int j =0; j<result->size();++j)
-    {
-        newItem = new QTableWidgetItem(QString::fromStdString(result->at(j).first)); // wyswietlanie liczby wezlow
-        ui->tableWidgetRandom->setItem(j, 0, newItem);
+            newItem = new QTableWidgetItem(QString::number((*multiTimes)[i],'f',2)); // czas jednego przebiegu
+            ui->tableWidget->setItem(i, 2, newItem);
 
-        newItem = new QTableWidgetItem(QString::number(result->at(j).second)); // wyswietlanie liczby krawedzi
-        ui->tableWidgetRandom->setItem(j, 1, newItem);
-    }
+            newItem = new QTableWidgetItem(QString::number((*separateTimes)[i]/(*multiTimes)[i],'f',2)); // przyspieszenie
+            ui->tableWidget->setItem(i, 3, newItem);
+        }
 
-    ui->stackedWidget->setCurrentIndex(2);
-    delete result;
+        ui->stackedWidget->setCurrentIndex(1);
+        ui->tableWidget->horizontalHeader()->setVisible(true);
+    });
 }
 
-void ErdosWindow::on_backButton_clicked()
+void ErdosWindow::getXMLSolution(const QString &fileName)
 {
-    ui->stackedWidget->setCurrentIndex(0);
-}
+    /**
+     * \brief Wynik zadania czytajacego plik XML
+     */
+    struct XmlJob
+    {
+        bool opened = false; /**< Czy otwarto plik */
+        int count = 0; /**< Liczba wczytanych scenariuszy */
+        QString error; /**< Opis bledu pliku (pusty - brak bledu) */
+        vector<ScenarioResult> results; /**< Wyniki w kolejnosci pliku */
+    };
+
+    auto state = make_shared<XmlJob>();
+    bool publicationsOnly = ui->loadingButtonGroup->checkedId()!=0;
+    bool bipartite = ui->bipartiteCheckBox->isChecked();
+    Algorithm algorithm = checkedAlgorithm();
+    int threads = ui->threadsSpinBox->value();
+
+    //Watki nie moga odwolywac sie do GUI, wiec algorytm i liczba watkow sa ustalane z gory
+    startJob("Trwa rozwiązywanie scenariuszy", [fileName, publicationsOnly, bipartite, algorithm, threads, state](JobProgress& progress)
+    {
+        ScenarioData scenario;
+        ScenarioResult result;
+        QFile file(fileName);
 
-void ErdosWindow::on_solveXMLButton_clicked()
-{
-    QDomDocument document;
-    QString fileName = QFileDialog::getOpenFileName(nullptr, "Open File",
-                                                    "C://",
-                                                    "Plik Xml (*.xml)");
+        if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            return;
 
-    QFile file(fileName);
+        state->opened = true;
 
-       if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
-       {
-           QMessageBox::critical(this,"Bład","Nieudana próba otwarcia pliku");
-           return;
-       }
-       else
-       {
-           if(!document.setContent(&file))
-           {
-               QMessageBox::critical(this,"Bład","Nieudana próba załadowania pliku XML");
-               return;
-           }
-           file.close();
-       }
+        XmlScenarioReader reader(&file);
+        //Scenariusze rozwiazywane sa wspolbieznie przez pule, wiec pojedynczy scenariusz korzysta z jednego watku
+        ScenarioSolver solver(threads, publicationsOnly, bipartite, [algorithm](AuthorsGraph& graph)
+        {
+            return getRanks(graph, algorithm, 1);
+        }, &progress);
 
-       QDomElement root = document.firstChildElement();
+        //Czytanie pliku wyprzedza obliczenia co najwyzej o kilka scenariuszy; postep to przeczytana czesc pliku
+        while(!progress.isCancelled() && reader.readScenario(scenario))
+        {
+            solver.submit(move(scenario));
+            ++state->count;
+            progress.setSteps(file.pos(), file.size());
 
+            while(solver.tryNext(result))
+                state->results.push_back(move(result));
+        }
 
-       if(!loadScenarios(root))
-         QMessageBox::critical(this,"Bład","Nieudana próba załadowania pliku XML");
-       else
-       {
-           getXMLSolution();
-       }
+        if(progress.isCancelled()) // pula porzuca niepobrane scenariusze
+            return;
 
-}
+        if(reader.hasError())
+        {
+            state->error = reader.errorString();
+            return;
+        }
 
-bool ErdosWindow::loadScenarios(QDomElement root)
-{
-    scenarios.clear();
-    QDomNodeList scenarioList = root.elementsByTagName("Scenario");
+        solver.finish();
+        while(solver.next(result))
+            state->results.push_back(move(result));
+    },
+    [this, state](bool cancelled)
+    {
+        if(cancelled)
+            return;
 
-     if(scenarioList.count() ==0 )
-         return false;
+        if(!state->opened)
+        {
+            QMessageBox::critical(this,"Bład","Nieudana próba otwarcia pliku");
+            return;
+        }
 
-     for(int i = 0; i < scenarioList.count(); i++)
-     {
-        QDomNode itemnode = scenarioList.at(i);
+        if(!state->error.isEmpty())
+        {
+            QMessageBox::critical(this,"Bład","Nieudana próba załadowania pliku XML: " + state->error);
+            return;
+        }
 
-        //convert to element
-        if(itemnode.isElement())
+        if(state->count == 0) // brak scenariuszy
         {
-            QDomElement element = itemnode.toElement();
-            if(!loadScenario(element))
-                return false;
+            QMessageBox::critical(this,"Bład","Nieudana próba załadowania pliku XML");
+            return;
         }
-     }
-     return true;
+
+        ui->scenarioComboBox->clear(); // odlacza model od poprzednich wynikow
+        scenarioResults.swap(state->results);
+
+        //Lista jest juz kompletna, wiec model moze wskazywac na jej elementy
+        for(auto& scenarioResult: scenarioResults)
+            ui->scenarioComboBox->addItem("Scenariusz " + QString::number(scenarioResult.index + 1));
+
+        ui->stackedWidget->setCurrentIndex(3);
+    });
 }
 
-bool ErdosWindow::loadScenario(QDomElement root)
+void ErdosWindow::getRandomSolution()
 {
-    //Ladowanie autorow
-    pair<Authors,Publications> scenario;
-    QDomNodeList authorList = root.elementsByTagName("Authors");
+    /**
+     * \brief Dane wygenerowane przez zadanie
+     */
+    struct RandomJob
+    {
+        Authors authors; /**< Wygenerowani autorzy */
+        Publications publications; /**< Wygenerowane publikacje */
+        unique_ptr<AuthorsGraph::RankList> ranks; /**< Wynik */
+    };
 
-     if(authorList.count() !=1 )
-         return false;
+    auto state = make_shared<RandomJob>();
+    int size = ui->randomSizeSpinBox->value();
+    bool publicationsOnly = ui->loadingButtonGroup->checkedId()!=0;
+    bool bipartite = ui->bipartiteCheckBox->isChecked();
+    Algorithm algorithm = checkedAlgorithm();
+    int threads = ui->threadsSpinBox->value();
+    uint64_t seed = randomSeed();
 
-     QDomNode node = authorList.at(0);
-     QDomElement authorsRoot = node.toElement();
-     if(!loadAuthors(authorsRoot,scenario.first))
-        return false;
+    randomModel->clear(); // poprzedni wynik wskazuje na nazwiska przeladowywanego grafu
+    randomRanks.reset();
 
+    //Do zakonczenia zadania z grafu korzysta wylacznie watek roboczy
+    startJob("Trwa rozwiązywanie", [this, size, publicationsOnly, bipartite, algorithm, threads, seed, state](JobProgress& progress)
+    {
+        generateInput(size, state->authors, state->publications, seed);
 
-     //Ladowanie publikacji
-     QDomNodeList publicationList = root.elementsByTagName("Publications");
+        randomGraph.setBipartite(bipartite);
+        randomGraph.setBuildThreads(threads);
+        randomGraph.setProgress(&progress);
 
-      if(publicationList.count() !=1 )
-          return false;
+        if(!publicationsOnly) //pelne ladowanie
+            randomGraph.loadGraph(state->authors, state->publications);
+        else //ladowanie po publikacjach
+            randomGraph.loadGraph(state->publications);
 
-      node = publicationList.at(0);
-      QDomElement publicationRoot = node.toElement();
-      if(!loadPublications(publicationRoot,scenario.second))
-         return false;
+        if(!progress.isCancelled())
+            state->ranks.reset(getRanks(randomGraph, algorithm, threads));
 
-     scenarios.push_back(scenario);
-     return true;
+        randomGraph.setProgress(nullptr);
+    },
+    [this, state](bool cancelled)
+    {
+        QTreeWidgetItem *root;
+        QTreeWidgetItem *authorsRoot;
+        QTreeWidgetItem *publicationsRoot;
+        QTreeWidgetItem *publicationRoot;
 
-}
+        if(cancelled || !state->ranks)
+            return;
 
-bool ErdosWindow::loadAuthors(QDomElement root, Authors& authorList)
-{
-    bool erdosSpotted =false;
-    QDomNodeList authorNodeList = root.elementsByTagName("Author");
+        randomRanks = move(state->ranks);
 
-     if(authorNodeList.count() ==0 )
-         return false;
+        //Wyswietlanie struktury wylosowanych danych
+        ui->treeWidget->clear();
+        root = new QTreeWidgetItem(ui->treeWidget);
+        root->setText(0,"Scenariusz");
+        ui->treeWidget->addTopLevelItem(root);
 
-     for(int i = 0; i < authorNodeList.count(); i++)
-     {
-        QDomNode node = authorNodeList.at(i);
+        authorsRoot = new QTreeWidgetItem();
+        authorsRoot->setText(0,"Autorzy");
+        root->addChild(authorsRoot);
 
-        if(node.isElement())
-        {
-            QDomElement element = node.toElement();
-            auto name = element.attribute("Name").toStdString();
+        publicationsRoot = new QTreeWidgetItem();
+        publicationsRoot->setText(0,"Publikacje");
+        root->addChild(publicationsRoot);
 
-            if(name == "Erdos")
-                erdosSpotted = true;
+        //dodawanie autorów
+
+        for(auto& author: state->authors)
+        {
+            QTreeWidgetItem * authorItem = new QTreeWidgetItem();
+            authorItem->setText(0,QString::fromStdString(author));
+            authorsRoot->addChild(authorItem);
+        }
 
-            authorList.push_back(name);
+        int j = 1;
+        for(auto& publication: state->publications) //dodawanie publikacji
+        {
+            publicationRoot = new QTreeWidgetItem();
+            publicationRoot->setText(0,"Publikacja "+ QString::number(j));
+            publicationsRoot->addChild(publicationRoot);
 
+            for(auto& author: publication)
+            {
+                QTreeWidgetItem * authorItem = new QTreeWidgetItem();
+                authorItem->setText(0,QString::fromStdString(author));
+                publicationRoot->addChild(authorItem);
+            }
+            ++j;
         }
-     }
-     return erdosSpotted;
-}
 
-bool ErdosWindow::loadPublications(QDomElement root, Publications& publicationsList)
-{
-     Publication publication;
 
-     QDomNodeList publicationsNodeList = root.elementsByTagName("Publication");
+        randomModel->setRanks(randomRanks.get());
+        ui->stackedWidget->setCurrentIndex(2);
+    });
+}
 
-     if(publicationsNodeList.count() ==0 )
-          return false;
+bool ErdosWindow::startJob(const QString &message, Job::Work work, Job::Done done)
+{
+    if(!job->start(work, done))
+        return false;
 
-      for(int i = 0; i < publicationsNodeList.count(); i++)
-      {
-         QDomNode node = publicationsNodeList.at(i);
+    jobMessage = message;
 
-         if(node.isElement())
-         {
-             publication.clear();
-             QDomElement authorsRoot = node.toElement();
-             if(!loadPublication(authorsRoot,publication))
-                return false;
+    ui->analyzeButton->setEnabled(false);
+    ui->solveXMLButton->setEnabled(false);
+    ui->solveRandomButton->setEnabled(false);
+    cancelButton->setEnabled(true);
+    cancelButton->setVisible(true);
+    bar->setVisible(true);
 
-             publicationsList.push_back(publication);
+    return true;
+}
 
-         }
-      }
-      return true;
+void ErdosWindow::showJobProgress(quint64 stepsDone, quint64 stepsTotal, quint64 visited, quint64 edges)
+{
+    if(stepsTotal) // postep krokow zadania
+    {
+        bar->setRange(0, 100);
+        bar->setValue(100 * stepsDone / stepsTotal);
+    }
+    else // liczba krokow nieznana - pasek bez wartosci
+        bar->setRange(0, 0);
 
+    ui->statusBar->showMessage(jobMessage + " – odwiedzeni autorzy: " + QString::number(visited) +
+                               ", dodane krawędzie: " + QString::number(edges));
 }
 
-bool ErdosWindow::loadPublication (QDomElement root, Publication &pub)
+void ErdosWindow::jobFinished(bool cancelled)
 {
-    QDomNodeList authorNodeList = root.elementsByTagName("Author");
+    ui->analyzeButton->setEnabled(true);
+    ui->solveXMLButton->setEnabled(true);
+    ui->solveRandomButton->setEnabled(true);
+    cancelButton->setVisible(false);
+    bar->setVisible(false);
 
-     if(authorNodeList.count() ==0 )
-         return false;
+    if(cancelled)
+        ui->statusBar->showMessage("Przerwano", 3000);
+    else
+        ui->statusBar->clearMessage();
+}
 
-     for(int i = 0; i < authorNodeList.count(); i++)
-     {
-        QDomNode node = authorNodeList.at(i);
+void ErdosWindow::on_backButton_clicked()
+{
+    ui->stackedWidget->setCurrentIndex(0);
+}
 
-        if(node.isElement())
-        {
-            QDomElement element = node.toElement();
-            auto name = element.attribute("Name").toStdString();
+void ErdosWindow::on_solveXMLButton_clicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(nullptr, "Open File",
+                                                    "C://",
+                                                    "Plik Xml (*.xml)");
 
-            pub.push_back(name);
+    if(fileName.isEmpty()) // anulowano wybor pliku
+        return;
 
-        }
-     }
-     return true;
+    getXMLSolution(fileName);
 }
 
 void ErdosWindow::on_backButton2_clicked()
@@ -804,3 +853,21 @@ void ErdosWindow::on_backButton3_clicked()
 {
    ui->stackedWidget->setCurrentIndex(0);
 }
+
+void ErdosWindow::on_scenarioComboBox_currentIndexChanged(int index)
+{
+    if(index < 0) // lista scenariuszy zostala wyczyszczona
+        xmlModel->clear();
+    else
+        xmlModel->setRanks(scenarioResults[index].ranks.get());
+}
+
+void ErdosWindow::on_xmlFilterEdit_textChanged(const QString &text)
+{
+    xmlModel->setFilter(text);
+}
+
+void ErdosWindow::on_randomFilterEdit_textChanged(const QString &text)
+{
+    randomModel->setFilter(text);
+}
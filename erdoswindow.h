@@ -10,15 +10,22 @@
 
 #include <QMainWindow>
 #include <QProgressBar>
-#include <QtXml>
+#include "authorsgraph.h"
+#include "benchmark.h"
+#include "scenariosolver.h"
+#include "job.h"
 #include <vector>
 #include <string>
+#include <memory>
 
 
 namespace Ui {
 class ErdosWindow;
 }
 
+class RankTableModel;
+class QPushButton;
+
 /**
  * \brief Klasa odpowiadajaca za okno programu.
  *
@@ -47,6 +54,16 @@ private slots:
 
     void on_backButton3_clicked();/**< Wraca z ekranu wynikow losowych danych do ekranu startowego programu */
 
+    void on_scenarioComboBox_currentIndexChanged(int index);/**< Wyswietla wynik wybranego scenariusza XML */
+
+    void on_xmlFilterEdit_textChanged(const QString& text);/**< Filtruje wyniki scenariusza XML */
+
+    void on_randomFilterEdit_textChanged(const QString& text);/**< Filtruje wyniki losowych danych */
+
+    void showJobProgress(quint64 stepsDone, quint64 stepsTotal, quint64 visited, quint64 edges);/**< Wyswietla postep zadania */
+
+    void jobFinished(bool cancelled);/**< Przywraca okno do stanu sprzed uruchomienia zadania */
+
 private:
 
     /**
@@ -55,7 +72,9 @@ private:
     enum Algorithm
     {
         BFS,
-        DIJKSTRA
+        DIJKSTRA,
+        DOBFS, /**< BFS optymalizujacy kierunek (top-down / bottom-up) */
+        PARALLELBFS /**< Wielowatkowy BFS synchronizowany warstwami */
     };
 
     /**
@@ -70,20 +89,93 @@ private:
     typedef std::vector<std::string> Authors;/**< Lista Autorow */
     typedef std::vector<std::string> Publication; /**< Reprezntacja publikacji jako lista autorow */
     typedef std::vector<std::vector<std::string>> Publications;/**< Lista Publikacji */
-    typedef std::vector<std::pair<Authors,Publications>> Scenarios; /**< Lista Scenariuszy */
 
     Ui::ErdosWindow *ui;
     QProgressBar* bar; /**< Pasek ladowania */
+    QPushButton* cancelButton; /**< Przycisk przerywajacy zadanie */
+    Job* job; /**< Zadanie wykonywane w watku roboczym */
+    QString jobMessage; /**< Opis biezacego zadania na pasku stanu */
 
-    Scenarios scenarios; /**< Zbior scenariuszy do rozpatrzenia */
+    RankTableModel* xmlModel; /**< Model tabeli wynikow scenariuszy XML */
+    RankTableModel* randomModel; /**< Model tabeli wynikow losowych danych */
+    vector<ScenarioResult> scenarioResults; /**< Wyniki scenariuszy XML, wyswietlane przez xmlModel */
+    AuthorsGraph randomGraph; /**< Graf losowych danych - nazwiska wynikow wskazuja na jego tablice napisow */
+    unique_ptr<AuthorsGraph::RankList> randomRanks; /**< Wynik dla losowych danych, wyswietlany przez randomModel */
+
+    /**
+     * \brief Zwraca algorytm wybrany przez uzytkownika
+     * \return Zwraca algorytm grafowy zaznaczony w grupie przyciskow
+     */
+    Algorithm checkedAlgorithm() const;
+
+    /**
+     * \brief Oblicza liczby Erdosa wybranym algorytmem, bez odwolan do GUI (moze byc wywolywana z innych watkow)
+     * \param graph Zaladowany graf
+     * \param algorithm Algorytm grafowy
+     * \param threadCount Liczba watkow BFS rownoleglego
+     * \return Zwraca wskaznik na liste par nazwisko-liczba Erdosa
+     */
+    static AuthorsGraph::RankList * getRanks(AuthorsGraph& graph, Algorithm algorithm, int threadCount);
+
+    /**
+     * \brief Zwraca nazwe algorytmu w modelu (patrz AuthorsGraph::getAlgorithmNames)
+     * \param algorithm Algorytm grafowy
+     * \return Zwraca nazwe algorytmu
+     */
+    static string algorithmName(Algorithm algorithm);
+
+    /**
+     * \brief Zwraca nazwe algorytmu wyswietlana w GUI
+     * \param algorithm Algorytm grafowy
+     * \return Zwraca nazwe algorytmu
+     */
+    static QString algorithmTitle(Algorithm algorithm);
+
+    /**
+     * \brief Tworzy obiekt pomiarowy z liczba powtorzen i przebiegow rozgrzewajacych wybrana przez uzytkownika
+     * \return Zwraca obiekt pomiarowy
+     */
+    Benchmark createBenchmark() const;
 
     /**
-     * \brief Generuje losowe dane dla problemu liczb Erdosa
-     * \param n Liczba autorow(wierzcholkow) do utworzenia
-     * \param authors Wektor, do ktorego zostana zapisani autorzy
-     * \param publications wWktor, do ktorego zostana zapisane publikacje
+     * \brief Zwraca model danych wybrany przez uzytkownika
+     * \return Zwraca model grafu zaznaczony na liscie modeli
      */
-    int generateInput(int n, std::vector<std::string> &authors, std::vector<std::vector<std::string>>& publications);
+    GraphModel checkedModel() const;
+
+    /**
+     * \brief Tworzy parametry generatora dla wybranego modelu, z losowym ziarnem
+     * \param n Liczba autorow
+     * \return Zwraca parametry generatora
+     */
+    GeneratorParams generatorParams(int n) const;
+
+    /**
+     * \brief Generuje losowy graf i laduje go, bez odwolan do GUI (moze byc wywolywana z innych watkow).
+     * Generator zglasza postep zadania, do ktorego przypiety jest graf
+     * \param params Parametry generatora (patrz generatorParams)
+     * \param bipartite Czy graf ma przechowywac publikacje jako hiperkrawedzie
+     * \param graph Graf, do ktorego zostana zaladowane dane
+     * \return Zwraca liczbe krawedzi grafu
+     */
+    static int generateGraph(GeneratorParams params, bool bipartite, AuthorsGraph& graph);
+
+    /**
+     * \brief Uruchamia zadanie w watku roboczym i blokuje przyciski rozpoczynajace kolejne zadania
+     * \param message Opis zadania na pasku stanu
+     * \param work Funkcja zadania - nie moze odwolywac sie do GUI
+     * \param done Funkcja wyswietlajaca wyniki, wywolywana w watku GUI
+     * \return Zwraca false, jesli poprzednie zadanie jeszcze trwa
+     */
+    bool startJob(const QString& message, Job::Work work, Job::Done done);
+
+    /**
+     * \brief Wykonuje w tle serie pomiarow i wyswietla ich statystyki w tabeli analizy
+     * \param plan Plan serii pomiarow
+     * \param title Opis analizy
+     * \param complexity Zlozonosc teoretyczna wyswietlana pod tabela
+     */
+    void showBenchmark(const BenchmarkPlan& plan, const QString& title, const QString& complexity);
 
     /**
      * \brief Dokonuje analizy wybranego algorytmu ladowania danych
@@ -91,7 +183,6 @@ private:
      * \param step O ile autorow wiecej maja miec kolejne analizowane instacje problemu
      * \param stepNo Liczba probek do przeanalizowania
      * \param loadMode Algorytm ladowania do przeanalizowania
-     * \return Zwraca liczbe utworzonych krawedzi
      */
     void analyzeLoading (int startCount, int step, int stepNo, Loading loadMode);
 
@@ -116,52 +207,36 @@ private:
     void fullAnalisis (int startCount, int step, int stepNo, Loading loadMode, Algorithm algorithm);
 
     /**
-     * \brief Oblicza i wyswietla liczby Erdosa dla danych zaladowanych z pliku XML
-     */
-    void getXMLSolution();
-
-    /**
-     * \brief Oblicza i wyswietla liczby Erdosa dla danych wygenerowanych losowo
+     * \brief Mierzy przyspieszenie BFS rownoleglego wzgledem liczby watkow
+     * \param n Liczba autorow wygenerowanego grafu
+     * \param maxThreads Najwieksza liczba watkow do przeanalizowania
      */
-    void getRandomSolution();
+    void analyzeScaling (int n, int maxThreads);
 
     /**
-     * \brief Laduje scenariusze z pliku XML
-     * \param root Korzen pliku XML zawierajacy scenariusze
-     * \return Zwraca true, jesli operacja sie powiodla, a w przeciwnym wypadku false
+     * \brief Porownuje czas algorytmu Dijkstry dla roznych kolejek priorytetowych
+     * \param n Liczba autorow wygenerowanego grafu
      */
-    bool loadScenarios(QDomElement root);
+    void analyzeQueues (int n);
 
     /**
-     * \brief Laduje scenariusz z pliku XML
-     * \param root Korzen pliku XML zawierajacy pojedynczy scenariusz
-     * \return Zwraca true, jesli operacja sie powiodla, a w przeciwnym wypadku false
+     * \brief Porownuje czas osobnych przebiegow BFS z jednym przebiegiem BFS wielozrodlowego dla 64, 128 i 256 zrodel
+     * \param n Liczba autorow wygenerowanego grafu
      */
-    bool loadScenario(QDomElement root);
+    void analyzeMultiSource (int n);
 
     /**
-     * \brief Laduje autorow danego scenariusza z pliku XML
-     * \param root Korzen pliku XML zawierajacy autorow danego scenariusza
-     * \param authorList Wektor do zapisu autorow
-     * \return Zwraca true, jesli operacja sie powiodla, a w przeciwnym wypadku false
+     * \brief Oblicza w tle i wyswietla liczby Erdosa dla kolejnych scenariuszy czytanych strumieniowo z pliku XML.
+     * Scenariusze budowane i rozwiazywane sa rownolegle na puli watkow (ScenarioSolver), a wyniki wyswietlane w kolejnosci pliku.
+     * Bledy pliku zglaszane sa po zakonczeniu zadania
+     * \param fileName Sciezka do pliku
      */
-    bool loadAuthors(QDomElement root, Authors &authorList);
+    void getXMLSolution(const QString& fileName);
 
     /**
-     * \brief Laduje publikacje danego scenariusza z pliku XML
-     * \param root Korzen pliku XML zawierajacy publikacje danego scenariusza
-     * \param publicationsList Wektor do zapisu publikacji
-     * \return Zwraca true, jesli operacja sie powiodla, a w przeciwnym wypadku false
+     * \brief Oblicza w tle i wyswietla liczby Erdosa dla danych wygenerowanych losowo
      */
-    bool loadPublications(QDomElement root, Publications &publicationsList);
-
-    /**
-     * \brief Laduje autorow danej publikacji z pliku XML
-     * \param root Korzen pliku XML zawierajacy autorow danej publikacji
-     * \param pub Wektor do zapisu autorow danej publikacji
-     * \return Zwraca true, jesli operacja sie powiodla, a w przeciwnym wypadku false
-     */
-    bool loadPublication(QDomElement root, Publication& pub);
+    void getRandomSolution();
 };
 
 #endif // ERDOSWINDOW_H
@@ -0,0 +1,380 @@
+/**
+ * \file   generator.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Generowanie losowych danych wejsciowych problemu liczb Erdosa
+ */
+
+#include "generator.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+
+namespace
+{
+/**
+ * \brief Strumienie losowych decyzji - rozne decyzje o tym samym numerze korzystaja z niezaleznych liczb
+ */
+enum Stream
+{
+    QUADRATIC_PICKS,
+    BA_TARGET,
+    RMAT_EDGE,
+    TEAM_SIZE,
+    TEAM_MEMBER,
+    TEAM_AUTHOR
+};
+
+/**
+ * \brief Funkcja mieszajaca splitmix64
+ */
+uint64_t mix(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * \brief Zwraca losowa liczbe decyzji index strumienia stream - zalezy tylko od argumentow
+ */
+uint64_t random(uint64_t seed, Stream stream, uint64_t index)
+{
+    return mix(mix(seed * 8 + stream) ^ index);
+}
+
+/**
+ * \brief Zamienia losowa liczbe na wartosc z przedzialu [0, 1)
+ */
+double uniform(uint64_t r)
+{
+    return (r >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * \brief Generator sekwencyjny dla decyzji zaleznych od siebie (splitmix64)
+ */
+class SplitMix
+{
+    uint64_t state; /**< Stan generatora */
+
+public:
+    explicit SplitMix(uint64_t seed) : state(seed)
+    {}
+
+    uint64_t next()
+    {
+        return mix(state++);
+    }
+};
+
+/**
+ * \brief Liczba publikacji autora i w generatorze kwadratowym
+ */
+uint64_t quadraticCount(uint64_t i)
+{
+    return i <= 2 ? 1 : i/2;
+}
+
+/**
+ * \brief Generator kwadratowy: autor i (i = 1..n-1) publikuje z i/2 roznymi autorami o mniejszych numerach
+ */
+void generateQuadratic(const GeneratorParams& params, SyntheticPublications& publications)
+{
+    uint64_t n = params.authors;
+    vector<uint64_t> first(n + 1, 0); // poczatek publikacji autora i
+
+    for(uint64_t i = 1; i < n; ++i)
+        first[i+1] = first[i] + quadraticCount(i);
+
+    publications.members.resize(2 * first[n]);
+
+    parallelFor(n, 64, params.threads, params.progress, [&](uint64_t begin, uint64_t end)
+    {
+        vector<char> picked(n, 0);
+        vector<AuthorsGraph::AuthorId> picks;
+
+        for(uint64_t i = max<uint64_t>(begin, 1); i < end; ++i)
+        {
+            SplitMix rng(random(params.seed, QUADRATIC_PICKS, i));
+            uint64_t k = quadraticCount(i);
+
+            picks.clear();
+            for(uint64_t j = i - k; j < i; ++j) // algorytm Floyda - k roznych liczb z [0, i) bez odrzucen
+            {
+                uint64_t t = rng.next() % (j + 1);
+                uint64_t pick = picked[t] ? j : t;
+                picked[pick] = 1;
+                picks.push_back(pick);
+            }
+
+            sort(picks.begin(), picks.end());
+
+            AuthorsGraph::AuthorId* out = publications.members.data() + 2 * first[i];
+            for(auto pick: picks)
+            {
+                picked[pick] = 0;
+                *out++ = i;
+                *out++ = pick;
+            }
+        }
+    });
+}
+
+/**
+ * \brief Preferencyjne dolaczanie (algorytm Sandersa-Schulza): krawedz e laczy autora e / degree z koncem
+ * losowo wybranej wczesniejszej krawedzi, co daje prawdopodobienstwo proporcjonalne do stopnia autora.
+ * Koniec wczesniejszej krawedzi wyznaczany jest ponownie z funkcji mieszajacej, zamiast odczytu z pamieci
+ */
+void generatePreferential(const GeneratorParams& params, SyntheticPublications& publications)
+{
+    uint64_t degree = max(params.degree, 1);
+    uint64_t count = (uint64_t)params.authors * degree;
+
+    publications.members.resize(2 * count);
+
+    parallelFor(count, 1 << 16, params.threads, params.progress, [&](uint64_t begin, uint64_t end)
+    {
+        for(uint64_t e = begin; e < end; ++e)
+        {
+            uint64_t slot = e;
+            uint64_t target = 0;
+
+            while(slot > 0)
+            {
+                uint64_t r = random(params.seed, BA_TARGET, slot) % (2 * slot);
+
+                if(r % 2 == 0) // poczatek krawedzi r/2 - znany bez losowania
+                {
+                    target = r / 2 / degree;
+                    break;
+                }
+
+                slot = r / 2; // koniec krawedzi r/2 - losowany tak samo
+            }
+
+            publications.members[2*e] = e / degree;
+            publications.members[2*e + 1] = target;
+        }
+    });
+}
+
+/**
+ * \brief R-MAT: kazda krawedz wybiera rekurencyjnie jedna z czterech cwiartek macierzy sasiedztwa 2^k x 2^k.
+ * Krawedzie poza zakresem autorow sa losowane ponownie
+ */
+void generateRmat(const GeneratorParams& params, SyntheticPublications& publications)
+{
+    uint64_t n = params.authors;
+    uint64_t count = n * max(params.degree, 1);
+    int scale = 0;
+
+    while((1ULL << scale) < n)
+        ++scale;
+
+    double ab = params.rmatA + params.rmatB;
+    double abc = ab + params.rmatC;
+
+    publications.members.resize(2 * count);
+
+    parallelFor(count, 1 << 14, params.threads, params.progress, [&](uint64_t begin, uint64_t end)
+    {
+        for(uint64_t e = begin; e < end; ++e)
+        {
+            SplitMix rng(random(params.seed, RMAT_EDGE, e));
+            uint64_t u, v;
+
+            do
+            {
+                u = v = 0;
+                for(int level = 0; level < scale; ++level)
+                {
+                    double p = uniform(rng.next());
+                    u = 2*u + (p >= ab);
+                    v = 2*v + ((p >= params.rmatA && p < ab) || p >= abc);
+                }
+            } while(u >= n || v >= n);
+
+            publications.members[2*e] = u;
+            publications.members[2*e + 1] = v;
+        }
+    });
+}
+
+/**
+ * \brief Zespoly: liczba autorow publikacji ma rozklad potegowy, a kazde miejsce w zespole z prawdopodobienstwem 1/2
+ * zajmuje losowy autor, a w przeciwnym razie autor losowego wczesniejszego miejsca (model Simona). Liczba publikacji
+ * autora ma wtedy rozklad potegowy, a Erdos zajmuje pierwsze miejsce
+ */
+void generateTeams(const GeneratorParams& params, SyntheticPublications& publications)
+{
+    uint64_t n = params.authors;
+    int maxTeamSize = max(params.maxTeamSize, 2);
+    vector<double> cdf; // dystrybuanta rozkladu liczby autorow 2..maxTeamSize
+    double total = 0;
+    double mean = 0;
+
+    for(int k = 2; k <= maxTeamSize; ++k)
+    {
+        double p = pow(k, -params.teamExponent);
+        total += p;
+        mean += k * p;
+        cdf.push_back(total);
+    }
+
+    mean /= total;
+    for(auto& p: cdf)
+        p /= total;
+
+    uint64_t count = max<uint64_t>(1, llround(n * max(params.degree, 1) / mean));
+    auto& offsets = publications.offsets;
+
+    offsets.assign(count + 1, 0);
+
+    parallelFor(count, 1 << 16, params.threads, params.progress, [&](uint64_t begin, uint64_t end)
+    {
+        for(uint64_t i = begin; i < end; ++i)
+        {
+            double u = uniform(random(params.seed, TEAM_SIZE, i));
+            offsets[i+1] = 2 + (upper_bound(cdf.begin(), cdf.end() - 1, u) - cdf.begin());
+        }
+    });
+
+    for(uint64_t i = 0; i < count; ++i)
+        offsets[i+1] += offsets[i];
+
+    publications.members.resize(offsets[count]);
+
+    parallelFor(offsets[count], 1 << 16, params.threads, params.progress, [&](uint64_t begin, uint64_t end)
+    {
+        for(uint64_t s = begin; s < end; ++s)
+        {
+            uint64_t slot = s;
+            uint64_t r;
+
+            while(slot > 0 && (r = random(params.seed, TEAM_MEMBER, slot)) % 2 == 0)
+                slot = (r >> 1) % slot; // kopiowanie autora wczesniejszego miejsca
+
+            publications.members[s] = slot == 0 ? 0 : random(params.seed, TEAM_AUTHOR, slot) % n;
+        }
+    });
+}
+}
+
+
+int generateInput(int n, vector<string> &authors, vector<vector<string>>& publications, uint64_t seed)
+{
+    GeneratorParams params;
+    SyntheticPublications generated;
+
+    if (n<10)
+        return 0;
+
+    params.model = QUADRATIC;
+    params.authors = n;
+    params.seed = seed;
+    generatePublications(params, generated);
+    toStrings(generated, authors, publications);
+
+    return generated.count();
+}
+
+void generatePublications(const GeneratorParams &params, SyntheticPublications &publications)
+{
+    publications.authors = max(params.authors, 1);
+    publications.offsets.clear();
+    publications.members.clear();
+
+    switch(params.model)
+    {
+    case QUADRATIC:
+        generateQuadratic(params, publications);
+        break;
+    case RMAT:
+        generateRmat(params, publications);
+        break;
+    case TEAMS:
+        generateTeams(params, publications);
+        break;
+    default:
+        generatePreferential(params, publications);
+    }
+}
+
+void loadSynthetic(const SyntheticPublications &publications, AuthorsGraph &graph)
+{
+    vector<AuthorsGraph::AuthorId> publication;
+    JobProgress* progress = graph.getProgress();
+    uint64_t edges = 0; // krawedzie dodane od poprzedniego punktu kontrolnego
+    char name[16];
+
+    graph.clear();
+    graph.addAuthor("Erdos");
+
+    for(int i = 1; i < publications.authors; ++i) // kolejne identyfikatory areny - autor i otrzymuje identyfikator i
+        graph.addAuthor(string_view(name, snprintf(name, sizeof(name), "%d", i)));
+
+    for(size_t i = 0; i < publications.count(); ++i)
+    {
+        publication.assign(publications.begin(i), publications.end(i));
+        graph.addPublication(publication);
+        edges += graph.isBipartite() ? publication.size() : publication.size() * (publication.size() - 1) / 2;
+
+        if(progress && (i + 1) % AuthorsGraph::PROGRESS_INTERVAL == 0 && !progress->report(0, exchange(edges, 0)))
+        {
+            graph.clear();
+            return;
+        }
+    }
+
+    if(progress)
+        progress->report(0, edges);
+
+    graph.freeze();
+}
+
+void toStrings(const SyntheticPublications &publications, vector<string> &authors, vector<vector<string>> &names)
+{
+    authors.clear();
+    names.clear();
+
+    authors.push_back("Erdos");
+    for(int i = 1; i < publications.authors; ++i)
+        authors.push_back(to_string(i));
+
+    names.resize(publications.count());
+    for(size_t i = 0; i < publications.count(); ++i)
+        for(auto id = publications.begin(i); id != publications.end(i); ++id)
+            names[i].push_back(authors[*id]);
+}
+
+const char* modelName(GraphModel model)
+{
+    switch(model)
+    {
+    case QUADRATIC:
+        return "quadratic";
+    case RMAT:
+        return "rmat";
+    case TEAMS:
+        return "teams";
+    default:
+        return "ba";
+    }
+}
+
+bool findModel(const string &name, GraphModel &model)
+{
+    for(GraphModel m: {QUADRATIC, PREFERENTIAL_ATTACHMENT, RMAT, TEAMS})
+        if(name == modelName(m))
+        {
+            model = m;
+            return true;
+        }
+
+    return false;
+}
@@ -0,0 +1,137 @@
+/**
+ * \file   generator.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Generowanie losowych danych wejsciowych problemu liczb Erdosa
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "authorsgraph.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Typ wyliczeniowy okreslajacy model losowego grafu
+ */
+enum GraphModel
+{
+    QUADRATIC, /**< Pierwotny generator - okolo n^2/4 publikacji dwuautorskich */
+    PREFERENTIAL_ATTACHMENT, /**< Model Barabasiego-Alberta - kazdy nowy autor publikuje z degree wczesniejszymi */
+    RMAT, /**< R-MAT - krawedzie losowane rekurencyjnie w cwiartkach macierzy sasiedztwa */
+    TEAMS /**< Publikacje wieloautorskie o potegowym rozkladzie liczby autorow */
+};
+
+/**
+ * \brief Parametry generatora
+ */
+struct GeneratorParams
+{
+    GraphModel model = PREFERENTIAL_ATTACHMENT; /**< Model grafu */
+    int authors = 1000; /**< Liczba autorow (autor 0 to Erdos) */
+    int degree = 8; /**< Preferencyjne dolaczanie: krawedzie nowego autora, R-MAT: krawedzie na autora,
+                         zespoly: publikacje na autora */
+    double rmatA = 0.57; /**< R-MAT: prawdopodobienstwo lewej gornej cwiartki */
+    double rmatB = 0.19; /**< R-MAT: prawdopodobienstwo prawej gornej cwiartki */
+    double rmatC = 0.19; /**< R-MAT: prawdopodobienstwo lewej dolnej cwiartki (prawa dolna - reszta) */
+    double teamExponent = 2.5; /**< Zespoly: wykladnik rozkladu liczby autorow P(k) ~ k^-teamExponent */
+    int maxTeamSize = 20; /**< Zespoly: najwieksza liczba autorow publikacji */
+    uint64_t seed = 1; /**< Ziarno - te same parametry i ziarno daja te same dane niezaleznie od liczby watkow */
+    int threads = 1; /**< Liczba watkow generatora */
+    JobProgress* progress = nullptr; /**< Postep zadania - po zadaniu przerwania generator konczy prace, a dane sa niekompletne */
+};
+
+/**
+ * \brief Publikacje wygenerowane w postaci identyfikatorow autorow, bez napisow.
+ *
+ * Autor i ma nazwisko "Erdos" (i = 0) lub zapis dziesietny liczby i, a po zaladowaniu do pustego grafu
+ * otrzymuje identyfikator i (przy kolejnosci wezlow innej niz NATURAL_ORDER - pierwotny identyfikator i, patrz
+ * AuthorsGraph::getOriginalId).
+ */
+struct SyntheticPublications
+{
+    int authors = 0; /**< Liczba autorow */
+    vector<uint64_t> offsets; /**< Publikacja i to members[offsets[i]..offsets[i+1]). Puste - wszystkie publikacje dwuautorskie */
+    vector<AuthorsGraph::AuthorId> members; /**< Skonkatenowane listy autorow publikacji */
+
+    /**
+     * \brief Zwraca liczbe publikacji
+     */
+    size_t count() const
+    {
+        return offsets.empty() ? members.size() / 2 : offsets.size() - 1;
+    }
+
+    /**
+     * \brief Zwraca wskaznik na pierwszego autora publikacji
+     */
+    const AuthorsGraph::AuthorId* begin(size_t i) const
+    {
+        return members.data() + (offsets.empty() ? 2*i : offsets[i]);
+    }
+
+    /**
+     * \brief Zwraca wskaznik za ostatniego autora publikacji
+     */
+    const AuthorsGraph::AuthorId* end(size_t i) const
+    {
+        return members.data() + (offsets.empty() ? 2*i + 2 : offsets[i+1]);
+    }
+};
+
+/**
+ * \brief Generuje losowe dane dla problemu liczb Erdosa (okolo n^2/4 publikacji dwuautorskich)
+ * \param n Liczba autorow(wierzcholkow) do utworzenia
+ * \param authors Wektor, do ktorego zostana zapisani autorzy
+ * \param publications Wektor, do ktorego zostana zapisane publikacje
+ * \param seed Ziarno generatora
+ * \return Zwraca liczbe wygenerowanych krawedzi (0 dla n < 10)
+ */
+int generateInput(int n, vector<string> &authors, vector<vector<string>>& publications, uint64_t seed);
+
+/**
+ * \brief Generuje publikacje wybranym modelem, wspolbieznie na params.threads watkach.
+ *
+ * Kazda losowa decyzja wyznaczana jest funkcja mieszajaca z ziarna i numeru decyzji, wiec wynik nie zalezy
+ * od liczby watkow ani kolejnosci ich wykonania
+ * \param params Parametry generatora
+ * \param publications Zmienna, do ktorej zostana zapisane publikacje
+ */
+void generatePublications(const GeneratorParams& params, SyntheticPublications& publications);
+
+/**
+ * \brief Laduje wygenerowane publikacje do grafu (po publikacjach, z wszystkimi autorami) i zamraza go.
+ * Zglasza postep zadania, do ktorego przypiety jest graf (patrz AuthorsGraph::setProgress)
+ * \param publications Wygenerowane publikacje
+ * \param graph Graf, ktorego poprzednia zawartosc zostanie usunieta
+ */
+void loadSynthetic(const SyntheticPublications& publications, AuthorsGraph& graph);
+
+/**
+ * \brief Zamienia wygenerowane publikacje na listy nazwisk (dla metod loadGraph)
+ * \param publications Wygenerowane publikacje
+ * \param authors Wektor, do ktorego zostana zapisani autorzy
+ * \param names Wektor, do ktorego zostana zapisane publikacje
+ */
+void toStrings(const SyntheticPublications& publications, vector<string>& authors, vector<vector<string>>& names);
+
+/**
+ * \brief Zwraca nazwe modelu grafu
+ * \param model Model grafu
+ * \return Zwraca nazwe uzywana w programie pomiarowym (quadratic, ba, rmat, teams)
+ */
+const char* modelName(GraphModel model);
+
+/**
+ * \brief Wyszukuje model grafu po nazwie
+ * \param name Nazwa modelu (patrz modelName)
+ * \param model Zmienna, do ktorej zostanie zapisany model
+ * \return Zwraca true, jesli nazwa jest poprawna
+ */
+bool findModel(const string& name, GraphModel& model);
+
+#endif // GENERATOR_H
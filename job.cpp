@@ -0,0 +1,89 @@
+/**
+ * \file   job.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Wykonywanie dlugotrwalych operacji w watku roboczym, z postepem i przerwaniem
+ */
+
+#include "job.h"
+#include <QThread>
+#include <QTimer>
+
+using namespace std;
+
+
+const int Job::PROGRESS_PERIOD = 100;
+
+
+Job::Job(QObject *parent) : QObject(parent), thread(nullptr)
+{
+    timer = new QTimer(this);
+    timer->setInterval(PROGRESS_PERIOD);
+    connect(timer, &QTimer::timeout, this, &Job::poll);
+}
+
+Job::~Job()
+{
+    cancel();
+    wait();
+}
+
+bool Job::start(Work work, Done done)
+{
+    if(thread)
+        return false;
+
+    progress.reset();
+    this->done = done;
+
+    //Watek konczy sie sygnalem finished, ktory trafia do obiektu zadania przez kolejke zdarzen watku GUI
+    thread = QThread::create([this, work]{ work(progress); });
+    connect(thread, &QThread::finished, this, &Job::threadFinished);
+
+    thread->start();
+    timer->start();
+    poll();
+
+    return true;
+}
+
+void Job::wait()
+{
+    if(!thread)
+        return;
+
+    thread->wait();
+    timer->stop();
+    delete thread;
+    thread = nullptr;
+    done = nullptr;
+}
+
+void Job::cancel()
+{
+    progress.cancel();
+}
+
+void Job::poll()
+{
+    emit progressChanged(progress.getStepsDone(), progress.getStepsTotal(), progress.getVisited(), progress.getEdges());
+}
+
+void Job::threadFinished()
+{
+    if(!thread || sender() != thread) // watek zakonczony juz przez wait()
+        return;
+
+    bool cancelled = progress.isCancelled();
+    Done finish = move(done);
+
+    timer->stop();
+    poll();
+    thread->deleteLater();
+    thread = nullptr;
+
+    emit finished(cancelled);
+
+    if(finish) // funkcja konczaca moze juz uruchomic kolejne zadanie
+        finish(cancelled);
+}
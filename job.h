@@ -0,0 +1,102 @@
+/**
+ * \file   job.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Wykonywanie dlugotrwalych operacji w watku roboczym, z postepem i przerwaniem
+ */
+
+#ifndef JOB_H
+#define JOB_H
+
+#include <QObject>
+#include "jobprogress.h"
+#include <functional>
+
+class QThread;
+class QTimer;
+
+/**
+ * \brief Zadanie wykonywane w watku roboczym.
+ *
+ * Funkcja zadania dziala w osobnym watku i nie moze odwolywac sie do GUI - parametry odczytywane sa z okna przed
+ * uruchomieniem, a wyniki zapisywane do wspolnych danych, ktore po zakonczeniu watku odczytuje funkcja wykonywana
+ * w watku GUI. Postep (JobProgress) odczytywany jest co PROGRESS_PERIOD ms i przekazywany sygnalem progressChanged,
+ * a zakonczenie - sygnalem finished. Jednoczesnie wykonywane jest co najwyzej jedno zadanie.
+ */
+class Job : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void(JobProgress&)> Work; /**< Funkcja zadania - wykonywana w watku roboczym */
+    typedef std::function<void(bool cancelled)> Done; /**< Funkcja konczaca - wykonywana w watku GUI po zakonczeniu watku */
+
+    static const int PROGRESS_PERIOD; /**< Odstep odczytow postepu [ms] */
+
+    /**
+     * \brief Konstruktor
+     * \param parent Obiekt nadrzedny
+     */
+    explicit Job(QObject* parent = nullptr);
+
+    /**
+     * \brief Destruktor. Przerywa biezace zadanie i czeka na zakonczenie watku
+     */
+    ~Job();
+
+    /**
+     * \brief Uruchamia zadanie w watku roboczym
+     * \param work Funkcja zadania
+     * \param done Funkcja konczaca, wywolywana po sygnale finished (moze byc pusta)
+     * \return Zwraca false, jesli poprzednie zadanie jeszcze trwa
+     */
+    bool start(Work work, Done done);
+
+    /**
+     * \brief Informuje czy zadanie trwa
+     */
+    bool isRunning() const
+    {
+        return thread != nullptr;
+    }
+
+    /**
+     * \brief Czeka na zakonczenie watku biezacego zadania (funkcja konczaca nie jest wtedy wywolywana)
+     */
+    void wait();
+
+public slots:
+    /**
+     * \brief Zada przerwania biezacego zadania. Zadanie konczy sie w najblizszym punkcie kontrolnym
+     */
+    void cancel();
+
+signals:
+    /**
+     * \brief Postep zadania
+     * \param stepsDone Wykonane kroki
+     * \param stepsTotal Liczba krokow (0 - nieznana)
+     * \param visited Liczba autorow odwiedzonych przez algorytmy
+     * \param edges Liczba krawedzi dodanych do budowanych grafow
+     */
+    void progressChanged(quint64 stepsDone, quint64 stepsTotal, quint64 visited, quint64 edges);
+
+    /**
+     * \brief Zadanie zakonczylo sie
+     * \param cancelled Czy zadanie przerwano
+     */
+    void finished(bool cancelled);
+
+private slots:
+    void poll(); /**< Odczytuje postep i wysyla sygnal progressChanged */
+
+    void threadFinished(); /**< Konczy zadanie po zakonczeniu watku roboczego */
+
+private:
+    JobProgress progress; /**< Postep biezacego zadania */
+    QThread* thread; /**< Watek biezacego zadania (lub nullptr) */
+    QTimer* timer; /**< Zegar odczytow postepu */
+    Done done; /**< Funkcja konczaca biezacego zadania */
+};
+
+#endif // JOB_H
@@ -0,0 +1,92 @@
+/**
+ * \file   jobprogress.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Postep i przerwanie dlugotrwalego zadania wykonywanego w innym watku
+ */
+
+#ifndef JOBPROGRESS_H
+#define JOBPROGRESS_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * \brief Wspolny stan zadania: liczniki postepu i zadanie przerwania.
+ *
+ * Watki zadania zwiekszaja liczniki i sprawdzaja przerwanie w stalych odstepach pracy (np. co 64K odwiedzonych autorow),
+ * a watek obserwatora (GUI) odczytuje je w dowolnej chwili. Wszystkie pola sa atomowe, wiec obiekt nie wymaga blokad.
+ * Przerwanie jest kooperacyjne - przerwany algorytm konczy sie w najblizszym punkcie kontrolnym i zwraca nullptr
+ * (lub pusty wynik), nie pozostawiajac niespojnych danych.
+ */
+class JobProgress
+{
+    std::atomic<bool> cancelled; /**< Czy zazadano przerwania */
+    std::atomic<uint64_t> stepsDone; /**< Wykonane kroki zadania (np. rozmiary serii, bajty pliku) */
+    std::atomic<uint64_t> stepsTotal; /**< Liczba krokow zadania (0 - nieznana) */
+    std::atomic<uint64_t> visited; /**< Suma autorow odwiedzonych przez algorytmy */
+    std::atomic<uint64_t> edges; /**< Suma krawedzi dodanych do budowanych grafow */
+
+public:
+    JobProgress() : cancelled(false), stepsDone(0), stepsTotal(0), visited(0), edges(0)
+    {}
+
+    /**
+     * \brief Zeruje liczniki i zadanie przerwania przed kolejnym zadaniem
+     */
+    void reset()
+    {
+        cancelled = false;
+        stepsDone = stepsTotal = visited = edges = 0;
+    }
+
+    /**
+     * \brief Zada przerwania zadania. Moze byc wywolywana z dowolnego watku
+     */
+    void cancel()
+    {
+        cancelled = true;
+    }
+
+    /**
+     * \brief Informuje czy zazadano przerwania
+     */
+    bool isCancelled() const
+    {
+        return cancelled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Ustawia postep krokow zadania
+     * \param done Wykonane kroki
+     * \param total Liczba krokow
+     */
+    void setSteps(uint64_t done, uint64_t total)
+    {
+        stepsTotal.store(total, std::memory_order_relaxed);
+        stepsDone.store(done, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Dolicza prace wykonana od poprzedniego punktu kontrolnego
+     * \param visitedCount Liczba odwiedzonych autorow
+     * \param edgeCount Liczba dodanych krawedzi
+     * \return Zwraca false, jesli zazadano przerwania
+     */
+    bool report(uint64_t visitedCount, uint64_t edgeCount)
+    {
+        if(visitedCount)
+            visited.fetch_add(visitedCount, std::memory_order_relaxed);
+        if(edgeCount)
+            edges.fetch_add(edgeCount, std::memory_order_relaxed);
+
+        return !isCancelled();
+    }
+
+    uint64_t getStepsDone() const { return stepsDone.load(std::memory_order_relaxed); } /**< Zwraca wykonane kroki */
+    uint64_t getStepsTotal() const { return stepsTotal.load(std::memory_order_relaxed); } /**< Zwraca liczbe krokow */
+    uint64_t getVisited() const { return visited.load(std::memory_order_relaxed); } /**< Zwraca liczbe odwiedzonych autorow */
+    uint64_t getEdges() const { return edges.load(std::memory_order_relaxed); } /**< Zwraca liczbe dodanych krawedzi */
+};
+
+#endif // JOBPROGRESS_H
@@ -0,0 +1,124 @@
+/**
+ * \file   mappedfile.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Plik odwzorowany w pamieci tylko do odczytu
+ */
+
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : address(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr)
+{}
+
+bool MappedFile::open(const std::string &path)
+{
+    LARGE_INTEGER fileSize;
+
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    address = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if(address == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    length = fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(address != nullptr)
+    {
+        UnmapViewOfFile(address);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+
+    address = nullptr;
+    length = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : address(nullptr), length(0)
+{}
+
+bool MappedFile::open(const std::string &path)
+{
+    struct stat info;
+
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    if(fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // odwzorowanie pozostaje wazne po zamknieciu deskryptora
+
+    if(mapped == MAP_FAILED)
+        return false;
+
+    address = static_cast<const char*>(mapped);
+    length = info.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(address != nullptr)
+        munmap(const_cast<char*>(address), length);
+
+    address = nullptr;
+    length = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
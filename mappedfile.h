@@ -0,0 +1,70 @@
+/**
+ * \file   mappedfile.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Plik odwzorowany w pamieci tylko do odczytu
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * \brief Plik odwzorowany w pamieci tylko do odczytu (mmap / MapViewOfFile).
+ *
+ * Strony pliku wczytywane sa przez system na zadanie, wiec otwarcie nawet bardzo duzego pliku trwa
+ * tyle co kilka wywolan systemowych. Odwzorowanie jest usuwane w destruktorze.
+ */
+class MappedFile
+{
+    const char* address; /**< Poczatek odwzorowania lub nullptr */
+    size_t length; /**< Rozmiar pliku w bajtach */
+#ifdef _WIN32
+    void* fileHandle; /**< Uchwyt pliku */
+    void* mappingHandle; /**< Uchwyt odwzorowania */
+#endif
+
+public:
+    /** Konstruktor pustego odwzorowania */
+    MappedFile();
+
+    /** Destruktor - usuwa odwzorowanie */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * \brief Odwzorowuje plik w pamieci
+     * \param path Sciezka do pliku
+     * \return Zwraca true, jesli operacja sie powiodla
+     */
+    bool open(const std::string& path);
+
+    /**
+     * \brief Usuwa odwzorowanie
+     */
+    void close();
+
+    /**
+     * \brief Zwraca poczatek odwzorowania
+     * \return Zwraca wskaznik na pierwszy bajt pliku
+     */
+    const char* data() const
+    {
+        return address;
+    }
+
+    /**
+     * \brief Zwraca rozmiar pliku
+     * \return Zwraca rozmiar pliku w bajtach
+     */
+    size_t size() const
+    {
+        return length;
+    }
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,264 @@
+/**
+ * \file   parallel.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Pomocnicze algorytmy rownolegle: petla blokowa, zespol watkow, sortowanie pozycyjne i sortowanie przez scalanie
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "jobprogress.h"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * \brief Wykonuje body(begin, end) dla blokow przedzialu [0, count) na kilku watkach.
+ * Bloki pobierane sa dynamicznie, wiec nierowny koszt blokow nie blokuje pozostalych watkow
+ * \param count Dlugosc przedzialu
+ * \param grain Dlugosc bloku
+ * \param threads Liczba watkow
+ * \param progress Postep zadania - po zadaniu przerwania watki nie pobieraja kolejnych blokow (moze byc nullptr)
+ * \param body Funkcja wykonywana dla bloku
+ */
+template<class Body>
+void parallelFor(uint64_t count, uint64_t grain, int threads, const JobProgress* progress, const Body& body)
+{
+    uint64_t blocks = (count + grain - 1) / grain;
+    std::atomic<uint64_t> nextBlock(0);
+
+    auto work = [&]
+    {
+        for(uint64_t block; (block = nextBlock++) < blocks && !(progress && progress->isCancelled()); )
+            body(block * grain, std::min(count, (block + 1) * grain));
+    };
+
+    std::vector<std::thread> workers;
+    for(uint64_t i = 1; i < std::min<uint64_t>(std::max(threads, 1), blocks); ++i)
+        workers.emplace_back(work);
+
+    work();
+
+    for(auto& worker: workers)
+        worker.join();
+}
+
+/**
+ * \brief Wykonuje body(slice, begin, end) dla rownych, ciaglych czesci przedzialu [0, count) - po jednej na watek.
+ * Stosowana, gdy kolejne fazy algorytmu musza dzielic przedzial identycznie
+ * \param count Dlugosc przedzialu
+ * \param slices Liczba czesci (watkow)
+ * \param body Funkcja wykonywana dla czesci
+ */
+template<class Body>
+void parallelSlices(uint64_t count, int slices, const Body& body)
+{
+    uint64_t size = (count + slices - 1) / slices;
+
+    parallelFor(slices, 1, slices, nullptr, [&](uint64_t slice, uint64_t)
+    {
+        body(slice, std::min(count, slice * size), std::min(count, (slice + 1) * size));
+    });
+}
+
+/**
+ * \brief Zespol watkow wielokrotnego uzytku.
+ *
+ * Watki pomocnicze uruchamiane sa przy pierwszym wywolaniu run, ktore ich potrzebuje, a pomiedzy wywolaniami czekaja
+ * na zmiennej warunkowej - kolejne wywolania nie tworza ani nie lacza watkow. Watek wywolujacy run wykonuje czesc 0.
+ * Wywolania run nie moga sie nakladac
+ */
+class ThreadTeam
+{
+public:
+    ThreadTeam() = default;
+
+    ThreadTeam(const ThreadTeam&) = delete;
+    ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+    /**
+     * \brief Destruktor. Konczy i laczy watki pomocnicze
+     */
+    ~ThreadTeam()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        started.notify_all();
+
+        for(auto& helper: helpers)
+            helper.join();
+    }
+
+    /**
+     * \brief Wykonuje body(id) dla id = 0..threads-1 na osobnych watkach i czeka na zakonczenie wszystkich czesci
+     * \param threads Liczba czesci (wartosci mniejsze od 1 traktowane sa jak 1)
+     * \param body Funkcja wykonywana dla czesci
+     */
+    template<class Body>
+    void run(int threads, const Body& body)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            participants = std::max(threads, 1);
+            pending = participants - 1;
+            task = [](const void* context, int id) { (*static_cast<const Body*>(context))(id); };
+            context = &body;
+
+            while((int)helpers.size() < pending) // nowy watek rozpoczyna od biezacej rundy
+                helpers.emplace_back(&ThreadTeam::loop, this, (int)helpers.size() + 1, round);
+
+            ++round;
+        }
+
+        started.notify_all();
+        body(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]{ return pending == 0; });
+    }
+
+private:
+    std::vector<std::thread> helpers; /**< Watki pomocnicze - watek i wykonuje czesc i+1 */
+    std::mutex mutex; /**< Chroni zlecenie i liczniki */
+    std::condition_variable started; /**< Nowa runda lub konczenie pracy */
+    std::condition_variable finished; /**< Wszystkie czesci rundy zakonczone */
+    void (*task)(const void*, int) = nullptr; /**< Wywolanie funkcji czesci biezacej rundy */
+    const void* context = nullptr; /**< Funkcja czesci biezacej rundy */
+    int participants = 0; /**< Liczba czesci biezacej rundy */
+    int pending = 0; /**< Liczba niezakonczonych czesci watkow pomocniczych */
+    unsigned round = 0; /**< Numer rundy */
+    bool stopping = false; /**< Czy watki maja sie zakonczyc */
+
+    /**
+     * \brief Petla watku pomocniczego
+     * \param id Numer czesci wykonywanej przez watek
+     * \param seen Ostatnia runda, ktora watek juz obsluzyl
+     */
+    void loop(int id, unsigned seen)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        for(;;)
+        {
+            started.wait(lock, [&]{ return stopping || round != seen; });
+
+            if(stopping)
+                return;
+
+            seen = round;
+
+            if(id >= participants) // runda z mniejsza liczba czesci
+                continue;
+
+            lock.unlock();
+            task(context, id);
+            lock.lock();
+
+            if(--pending == 0)
+                finished.notify_one();
+        }
+    }
+};
+
+/**
+ * \brief Stabilne sortowanie pozycyjne (LSD, cyfry 8-bitowe) kluczy mniejszych niz 2^bits.
+ * Kazdy watek zlicza cyfry swojej czesci tablicy, a nastepnie rozrzuca ja w miejsca wyznaczone przez sumy
+ * prefiksowe wszystkich czesci. Przebiegi, w ktorych wszystkie klucze maja te sama cyfre, sa pomijane
+ * \param keys Sortowane klucze
+ * \param bits Liczba znaczacych bitow kluczy
+ * \param threads Liczba watkow
+ */
+inline void parallelRadixSort(std::vector<uint64_t>& keys, int bits, int threads)
+{
+    const int DIGITS = 256;
+    int slices = std::max(1, std::min<int>(threads, keys.size() / 65536 + 1));
+    std::vector<uint64_t> buffer(keys.size());
+    std::vector<uint64_t> counts(size_t(slices) * DIGITS);
+
+    for(int shift = 0; shift < bits; shift += 8)
+    {
+        std::fill(counts.begin(), counts.end(), 0);
+
+        parallelSlices(keys.size(), slices, [&](uint64_t slice, uint64_t begin, uint64_t end)
+        {
+            uint64_t* count = &counts[slice * DIGITS];
+            for(uint64_t i = begin; i < end; ++i)
+                ++count[(keys[i] >> shift) & (DIGITS - 1)];
+        });
+
+        //Poczatek cyfry d w czesci s: klucze o mniejszych cyfrach oraz klucze o cyfrze d z wczesniejszych czesci
+        uint64_t position = 0;
+        bool trivial = false;
+
+        for(int d = 0; d < DIGITS; ++d)
+        {
+            uint64_t digitStart = position;
+
+            for(int s = 0; s < slices; ++s)
+            {
+                uint64_t count = counts[size_t(s) * DIGITS + d];
+                counts[size_t(s) * DIGITS + d] = position;
+                position += count;
+            }
+
+            trivial = trivial || position - digitStart == keys.size();
+        }
+
+        if(trivial) // przebieg nie zmienilby kolejnosci
+            continue;
+
+        parallelSlices(keys.size(), slices, [&](uint64_t slice, uint64_t begin, uint64_t end)
+        {
+            uint64_t* next = &counts[slice * DIGITS];
+            for(uint64_t i = begin; i < end; ++i)
+                buffer[next[(keys[i] >> shift) & (DIGITS - 1)]++] = keys[i];
+        });
+
+        keys.swap(buffer);
+    }
+}
+
+/**
+ * \brief Sortowanie przez scalanie: czesci tablicy sortowane sa rownolegle, a nastepnie scalane parami
+ * \param first Poczatek sortowanego przedzialu
+ * \param last Koniec sortowanego przedzialu
+ * \param less Porzadek
+ * \param threads Liczba watkow
+ */
+template<class Iterator, class Less>
+void parallelSort(Iterator first, Iterator last, const Less& less, int threads)
+{
+    uint64_t count = last - first;
+    int slices = std::max(1, std::min<int>(threads, count / 65536 + 1));
+    uint64_t size = (count + slices - 1) / slices;
+
+    parallelSlices(count, slices, [&](uint64_t, uint64_t begin, uint64_t end)
+    {
+        std::sort(first + begin, first + end, less);
+    });
+
+    for(uint64_t width = size; width < count; width *= 2) // kolejne rundy scalaja sasiednie pary posortowanych czesci
+    {
+        uint64_t pairs = (count + 2 * width - 1) / (2 * width);
+
+        parallelFor(pairs, 1, threads, nullptr, [&](uint64_t pair, uint64_t)
+        {
+            uint64_t begin = pair * 2 * width;
+            uint64_t middle = std::min(count, begin + width);
+            uint64_t end = std::min(count, begin + 2 * width);
+
+            std::inplace_merge(first + begin, first + middle, first + end, less);
+        });
+    }
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,346 @@
+/**
+ * \file   priorityqueues.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Kolejki priorytetowe o kluczach calkowitych, stosowane jako polityki algorytmu Dijkstry
+ */
+
+#ifndef PRIORITYQUEUES_H
+#define PRIORITYQUEUES_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "bitops.h"
+
+/*
+ * Wszystkie kolejki maja wspolny interfejs:
+ *   void push(int key, uint32_t value) - wstawia element
+ *   void pop(int& key, uint32_t& value) - zdejmuje element o najmniejszym kluczu
+ *   bool empty() const
+ *   void clear()
+ *   static const char* name()
+ * Zmniejszanie klucza realizowane jest leniwie: algorytm wstawia element ponownie, a nieaktualne wpisy pomija.
+ */
+
+
+/**
+ * \brief Kolejka kubelkowa Diala.
+ *
+ * Kubelek o indeksie k przechowuje elementy o kluczu k. Wymaga kluczy nieujemnych i monotonicznych
+ * (klucz wstawianego elementu nie mniejszy od ostatnio zdjetego), co dla wag jednostkowych i malych
+ * wag calkowitych daje operacje w czasie stalym.
+ */
+class BucketQueue
+{
+    std::vector<std::vector<uint32_t>> buckets; /**< Kubelki indeksowane kluczem */
+    size_t current; /**< Najmniejszy potencjalnie niepusty kubelek */
+    size_t count; /**< Liczba elementow */
+
+public:
+    BucketQueue() : current(0), count(0)
+    {}
+
+    static const char* name()
+    {
+        return "Kubełkowa (Dial)";
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    void push(int key, uint32_t value)
+    {
+        if((size_t)key >= buckets.size())
+            buckets.resize(key + 1);
+
+        buckets[key].push_back(value);
+        ++count;
+    }
+
+    void pop(int& key, uint32_t& value)
+    {
+        while(buckets[current].empty())
+            ++current;
+
+        key = current;
+        value = buckets[current].back();
+        buckets[current].pop_back();
+        --count;
+    }
+
+    void clear()
+    {
+        for(auto& b: buckets)
+            b.clear();
+        current = 0;
+        count = 0;
+    }
+};
+
+
+/**
+ * \brief Kopiec pozycyjny (radix heap).
+ *
+ * Element trafia do kubelka wyznaczonego przez najstarszy bit, ktorym jego klucz rozni sie od ostatnio
+ * zdjetego klucza. Wymaga kluczy monotonicznych; kazdy element jest przenoszony co najwyzej 32 razy.
+ */
+class RadixHeap
+{
+    typedef std::pair<uint32_t, uint32_t> Entry; /**< Para klucz-wartosc */
+
+    std::vector<Entry> buckets[33]; /**< Kubelek 0 - klucze rowne last, kubelek b - najstarszy rozny bit b-1 */
+    uint32_t last; /**< Ostatnio zdjety klucz */
+    size_t count; /**< Liczba elementow */
+
+    static int bucketOf(uint32_t key, uint32_t last)
+    {
+        return key == last ? 0 : 1 + highestBit(key ^ last);
+    }
+
+public:
+    RadixHeap() : last(0), count(0)
+    {}
+
+    static const char* name()
+    {
+        return "Pozycyjna (radix heap)";
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    void push(int key, uint32_t value)
+    {
+        buckets[bucketOf(key, last)].emplace_back(key, value);
+        ++count;
+    }
+
+    void pop(int& key, uint32_t& value)
+    {
+        if(buckets[0].empty()) // rozdziel pierwszy niepusty kubelek wzgledem jego minimum
+        {
+            int b = 1;
+            while(buckets[b].empty())
+                ++b;
+
+            uint32_t minKey = buckets[b][0].first;
+            for(auto& e: buckets[b])
+                if(e.first < minKey)
+                    minKey = e.first;
+
+            last = minKey;
+            for(auto& e: buckets[b])
+                buckets[bucketOf(e.first, last)].push_back(e);
+            buckets[b].clear();
+        }
+
+        key = buckets[0].back().first;
+        value = buckets[0].back().second;
+        buckets[0].pop_back();
+        --count;
+    }
+
+    void clear()
+    {
+        for(auto& b: buckets)
+            b.clear();
+        last = 0;
+        count = 0;
+    }
+};
+
+
+/**
+ * \brief Kopiec d-arny przechowywany w tablicy.
+ *
+ * Plytszy od kopca binarnego, a dzieci wezla leza obok siebie w pamieci, wiec przesiewanie w dol
+ * czyta jedna linie pamieci podrecznej na poziom.
+ */
+template<int D>
+class DAryHeap
+{
+    typedef std::pair<int, uint32_t> Entry; /**< Para klucz-wartosc */
+
+    std::vector<Entry> heap; /**< Elementy kopca */
+
+public:
+    static const char* name()
+    {
+        return D == 4 ? "Kopiec 4-arny" : "Kopiec d-arny";
+    }
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    void push(int key, uint32_t value)
+    {
+        size_t i = heap.size();
+        heap.emplace_back(key, value);
+
+        while(i > 0) // przesiewanie w gore
+        {
+            size_t parent = (i - 1) / D;
+            if(heap[parent].first <= key)
+                break;
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = Entry(key, value);
+    }
+
+    void pop(int& key, uint32_t& value)
+    {
+        key = heap[0].first;
+        value = heap[0].second;
+
+        Entry moved = heap.back();
+        heap.pop_back();
+        if(heap.empty())
+            return;
+
+        size_t i = 0;
+        size_t size = heap.size();
+
+        for(;;) // przesiewanie w dol
+        {
+            size_t first = i * D + 1;
+            if(first >= size)
+                break;
+
+            size_t best = first;
+            size_t end = first + D < size ? first + D : size;
+            for(size_t c = first + 1; c < end; ++c)
+                if(heap[c].first < heap[best].first)
+                    best = c;
+
+            if(heap[best].first >= moved.first)
+                break;
+
+            heap[i] = heap[best];
+            i = best;
+        }
+        heap[i] = moved;
+    }
+
+    void clear()
+    {
+        heap.clear();
+    }
+};
+
+
+/**
+ * \brief Kopiec parujacy.
+ *
+ * Wezly przechowywane sa w puli indeksowanej liczbami calkowitymi (dziecko - nastepne rodzenstwo),
+ * a zdjecie minimum scala poddrzewa dwuprzebiegowo.
+ */
+class PairingHeap
+{
+    struct Node
+    {
+        int key;
+        uint32_t value;
+        int32_t child; /**< Pierwsze dziecko lub -1 */
+        int32_t sibling; /**< Nastepne rodzenstwo lub -1 */
+    };
+
+    std::vector<Node> pool; /**< Pula wezlow */
+    std::vector<int32_t> freeNodes; /**< Zwolnione wezly puli */
+    std::vector<int32_t> pairs; /**< Bufor pierwszego przebiegu scalania */
+    int32_t root; /**< Korzen kopca lub -1 */
+    size_t count; /**< Liczba elementow */
+
+    int32_t meld(int32_t a, int32_t b)
+    {
+        if(a < 0)
+            return b;
+        if(b < 0)
+            return a;
+        if(pool[b].key < pool[a].key)
+            std::swap(a, b);
+
+        pool[b].sibling = pool[a].child;
+        pool[a].child = b;
+        return a;
+    }
+
+public:
+    PairingHeap() : root(-1), count(0)
+    {}
+
+    static const char* name()
+    {
+        return "Kopiec parujący";
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    void push(int key, uint32_t value)
+    {
+        int32_t n;
+        Node node = {key, value, -1, -1};
+
+        if(freeNodes.empty())
+        {
+            n = pool.size();
+            pool.push_back(node);
+        }
+        else
+        {
+            n = freeNodes.back();
+            freeNodes.pop_back();
+            pool[n] = node;
+        }
+
+        root = meld(root, n);
+        ++count;
+    }
+
+    void pop(int& key, uint32_t& value)
+    {
+        key = pool[root].key;
+        value = pool[root].value;
+        freeNodes.push_back(root);
+
+        pairs.clear(); // pierwszy przebieg - scalanie kolejnych par dzieci
+        for(int32_t c = pool[root].child; c >= 0; )
+        {
+            int32_t a = c;
+            int32_t b = pool[a].sibling;
+            c = b >= 0 ? pool[b].sibling : -1;
+
+            pool[a].sibling = -1;
+            if(b >= 0)
+                pool[b].sibling = -1;
+            pairs.push_back(meld(a, b));
+        }
+
+        root = -1; // drugi przebieg - scalanie od prawej do lewej
+        for(auto it = pairs.rbegin(); it != pairs.rend(); ++it)
+            root = meld(root, *it);
+
+        --count;
+    }
+
+    void clear()
+    {
+        pool.clear();
+        freeNodes.clear();
+        root = -1;
+        count = 0;
+    }
+};
+
+#endif // PRIORITYQUEUES_H
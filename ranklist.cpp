@@ -0,0 +1,78 @@
+/**
+ * \file   ranklist.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Wynik algorytmow - kolumnowa lista rang z leniwym odczytem nazwisk
+ */
+
+#include "ranklist.h"
+#include "authorsgraph.h"
+#include <limits>
+
+using namespace std;
+
+
+const int RankList::INFINITE = numeric_limits<int>::max();
+
+
+RankList::RankList(const AuthorsGraph *graph, vector<int32_t> &&ranks) : graph(graph), partial(false), ranks(move(ranks))
+{}
+
+RankList::RankList(const AuthorsGraph *graph, vector<AuthorId> &&authors, vector<int32_t> &&ranks) : graph(graph), partial(true),
+    authors(move(authors)), ranks(move(ranks))
+{}
+
+RankList::AuthorId RankList::getAuthor(size_t position) const
+{
+    return partial ? authors[position] : graph->getAlphabetical(position);
+}
+
+string_view RankList::getName(size_t position) const
+{
+    return graph->getName(getAuthor(position));
+}
+
+vector<uint32_t> RankList::sortedByRank(bool ascending) const
+{
+    vector<uint32_t> positions(size());
+
+    for(size_t i = 0; i < positions.size(); ++i)
+        positions[i] = i;
+
+    sortByRank(positions, ascending, [this](uint32_t i) { return getRank(i); });
+    return positions;
+}
+
+vector<size_t> RankList::histogram() const
+{
+    vector<size_t> counts;
+    size_t unreachable = 0;
+
+    for(int32_t rank: ranks) // kolejnosc nie ma znaczenia - tablica rang przegladana jest wprost
+    {
+        if(rank == INFINITE)
+        {
+            ++unreachable;
+            continue;
+        }
+
+        if((size_t)rank >= counts.size())
+            counts.resize(rank + 1, 0);
+
+        ++counts[rank];
+    }
+
+    counts.push_back(unreachable);
+    return counts;
+}
+
+vector<pair<string, int>> RankList::toStrings() const
+{
+    vector<pair<string, int>> result;
+    result.reserve(size());
+
+    for(size_t i = 0; i < size(); ++i)
+        result.emplace_back(string(getName(i)), getRank(i));
+
+    return result;
+}
@@ -0,0 +1,237 @@
+/**
+ * \file   ranklist.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Wynik algorytmow - kolumnowa lista rang z leniwym odczytem nazwisk
+ */
+
+#ifndef RANKLIST_H
+#define RANKLIST_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+class AuthorsGraph;
+
+/**
+ * \brief Lista rang autorow w kolejnosci alfabetycznej nazwisk.
+ *
+ * Lista pelna (wynik getRanks*) przechowuje jedynie tablice rang indeksowana identyfikatorem autora - zwykle
+ * przejeta bez kopiowania z tablicy odleglosci algorytmu - a kolejnosc alfabetyczna i nazwiska odczytuje z tablicy
+ * napisow grafu w chwili odwolania. Lista czesciowa (wynik addPublications) przechowuje wybranych autorow
+ * w kolejnosci alfabetycznej oraz ich rangi. Nazwiska i lista pelna sa wazne do kolejnej modyfikacji lub
+ * wyczyszczenia grafu.
+ */
+class RankList
+{
+public:
+    typedef uint32_t AuthorId; /**< Identyfikator autora grafu */
+    typedef std::pair<std::string_view, int> Entry; /**< Para nazwisko-ranga */
+
+    static const int INFINITE; /**< Ranga autora nieosiagalnego (rowna AuthorsGraph::INFINITE_RANK) */
+
+    /**
+     * \brief Iterator pozycji listy - wyznacza pary nazwisko-ranga w chwili odczytu
+     */
+    class const_iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef Entry value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Entry* pointer;
+        typedef Entry reference;
+
+        const_iterator(const RankList* list, size_t position) : list(list), position(position)
+        {}
+
+        Entry operator*() const
+        {
+            return (*list)[position];
+        }
+
+        const_iterator& operator++()
+        {
+            ++position;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            ++position;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return position == other.position;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return position != other.position;
+        }
+
+    private:
+        const RankList* list; /**< Przegladana lista */
+        size_t position; /**< Pozycja w kolejnosci alfabetycznej */
+    };
+
+    /**
+     * \brief Konstruktor listy pelnej
+     * \param graph Zamrozony graf, z ktorego odczytywane sa nazwiska
+     * \param ranks Rangi indeksowane identyfikatorem autora (getAuthorsCount() elementow)
+     */
+    RankList(const AuthorsGraph* graph, std::vector<int32_t>&& ranks);
+
+    /**
+     * \brief Konstruktor listy czesciowej
+     * \param graph Zamrozony graf, z ktorego odczytywane sa nazwiska
+     * \param authors Autorzy listy w kolejnosci alfabetycznej nazwisk
+     * \param ranks Rangi autorow (ranks[i] - ranga autora authors[i])
+     */
+    RankList(const AuthorsGraph* graph, std::vector<AuthorId>&& authors, std::vector<int32_t>&& ranks);
+
+    /**
+     * \brief Zwraca liczbe pozycji listy
+     */
+    size_t size() const
+    {
+        return partial ? authors.size() : ranks.size();
+    }
+
+    /**
+     * \brief Informuje czy lista jest pusta
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * \brief Zwraca autora pozycji listy
+     * \param position Pozycja w kolejnosci alfabetycznej
+     */
+    AuthorId getAuthor(size_t position) const;
+
+    /**
+     * \brief Zwraca nazwisko autora pozycji listy
+     * \param position Pozycja w kolejnosci alfabetycznej
+     * \return Zwraca widok na nazwisko w tablicy napisow grafu
+     */
+    std::string_view getName(size_t position) const;
+
+    /**
+     * \brief Zwraca range autora pozycji listy
+     * \param position Pozycja w kolejnosci alfabetycznej
+     * \return Zwraca range lub AuthorsGraph::INFINITE_RANK
+     */
+    int getRank(size_t position) const
+    {
+        return partial ? ranks[position] : ranks[getAuthor(position)];
+    }
+
+    /**
+     * \brief Zwraca pare nazwisko-ranga pozycji listy
+     * \param position Pozycja w kolejnosci alfabetycznej
+     */
+    Entry operator[](size_t position) const
+    {
+        return Entry(getName(position), getRank(position));
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+
+    /**
+     * \brief Informuje czy lista jest czesciowa (zawiera wybranych autorow)
+     */
+    bool isPartial() const
+    {
+        return partial;
+    }
+
+    /**
+     * \brief Zwraca tablice rang. Dla listy pelnej indeksowana jest identyfikatorem autora, dla czesciowej - pozycja
+     */
+    const std::vector<int32_t>& getRanks() const
+    {
+        return ranks;
+    }
+
+    /**
+     * \brief Porzadkuje pozycje wedlug rang (sortowanie przez zliczanie - rangi sa male). Pozycje o tej samej randze
+     * zachowuja kolejnosc, a nieosiagalne trafiaja na koniec (przy sortowaniu malejacym - na poczatek)
+     * \param positions Sortowane pozycje
+     * \param ascending Czy sortowac rosnaco
+     * \param rank Funkcja zwracajaca range pozycji (lub INFINITE)
+     */
+    template<class Rank>
+    static void sortByRank(std::vector<uint32_t>& positions, bool ascending, const Rank& rank)
+    {
+        int maxRank = 0;
+
+        for(auto i: positions)
+            if(rank(i) != INFINITE)
+                maxRank = std::max(maxRank, rank(i));
+
+        std::vector<uint32_t> starts(maxRank + 3, 0); // rangi 0..maxRank, a na koncu autorzy nieosiagalni
+        auto bucket = [&](uint32_t i)
+        {
+            int b = rank(i) == INFINITE ? maxRank + 1 : rank(i);
+            return ascending ? b : maxRank + 1 - b;
+        };
+
+        for(auto i: positions)
+            ++starts[bucket(i) + 1];
+
+        for(size_t b = 1; b < starts.size(); ++b)
+            starts[b] += starts[b - 1];
+
+        std::vector<uint32_t> sorted(positions.size());
+        for(auto i: positions)
+            sorted[starts[bucket(i)]++] = i;
+
+        positions.swap(sorted);
+    }
+
+    /**
+     * \brief Zwraca wszystkie pozycje listy w kolejnosci rang - autorzy o tej samej randze alfabetycznie (patrz sortByRank)
+     * \param ascending Czy sortowac rosnaco
+     */
+    std::vector<uint32_t> sortedByRank(bool ascending = true) const;
+
+    /**
+     * \brief Zlicza autorow o kolejnych rangach
+     * \return Zwraca liczby autorow o randze 0..r, gdzie r to najwieksza skonczona ranga, a w ostatnim elemencie
+     * liczbe autorow nieosiagalnych
+     */
+    std::vector<size_t> histogram() const;
+
+    /**
+     * \brief Kopiuje liste do par z wlasnymi nazwiskami, niezaleznymi od grafu
+     */
+    std::vector<std::pair<std::string, int>> toStrings() const;
+
+private:
+    const AuthorsGraph* graph; /**< Graf, z ktorego odczytywane sa nazwiska */
+    bool partial; /**< Czy lista jest czesciowa */
+    std::vector<AuthorId> authors; /**< Lista czesciowa: autorzy w kolejnosci alfabetycznej */
+    std::vector<int32_t> ranks; /**< Rangi (patrz getRanks) */
+};
+
+#endif // RANKLIST_H
@@ -0,0 +1,166 @@
+/**
+ * \file   ranktablemodel.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Model tabeli wynikow - leniwy odczyt listy rang z sortowaniem i filtrowaniem
+ */
+
+#include "ranktablemodel.h"
+#include <algorithm>
+#include <cctype>
+
+using namespace std;
+
+
+RankTableModel::RankTableModel(QObject *parent) : QAbstractTableModel(parent), views(nullptr), strings(nullptr), count(0),
+    mapped(false), sortColumn(0), sortOrder(Qt::AscendingOrder), filterRank(-1)
+{}
+
+void RankTableModel::setRanks(const AuthorsGraph::RankList *ranks)
+{
+    beginResetModel();
+    views = ranks;
+    strings = nullptr;
+    count = ranks ? ranks->size() : 0;
+    rebuild();
+    endResetModel();
+}
+
+void RankTableModel::setRanks(const vector<pair<string, int>> *ranks)
+{
+    beginResetModel();
+    views = nullptr;
+    strings = ranks;
+    count = ranks ? ranks->size() : 0;
+    rebuild();
+    endResetModel();
+}
+
+void RankTableModel::clear()
+{
+    setRanks((const AuthorsGraph::RankList*)nullptr);
+}
+
+int RankTableModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return mapped ? rows.size() : count;
+}
+
+int RankTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 2;
+}
+
+QVariant RankTableModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    uint32_t i = item(index.row());
+
+    if(index.column() == 0)
+    {
+        string_view n = name(i);
+        return QString::fromUtf8(n.data(), n.size());
+    }
+
+    if(rank(i) == AuthorsGraph::INFINITE_RANK)
+        return QString("∞");
+
+    return rank(i);
+}
+
+QVariant RankTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(role != Qt::DisplayRole)
+        return QVariant();
+
+    if(orientation == Qt::Vertical)
+        return section + 1;
+
+    return section == 0 ? QString("Nazwisko") : QString("Ranga");
+}
+
+void RankTableModel::sort(int column, Qt::SortOrder order)
+{
+    emit layoutAboutToBeChanged();
+    sortColumn = column;
+    sortOrder = order;
+    rebuild();
+    emit layoutChanged();
+}
+
+void RankTableModel::setFilter(const QString &filter)
+{
+    QByteArray utf8 = filter.trimmed().toUtf8();
+    string text(utf8.constData(), utf8.size());
+
+    filterName.clear();
+    filterRank = -1;
+
+    if(!text.empty() && text[0] == '=') // filtr rangi
+    {
+        text.erase(0, 1);
+
+        if(text == "inf")
+            filterRank = AuthorsGraph::INFINITE_RANK;
+        else if(!text.empty() && text.size() < 10 && all_of(text.begin(), text.end(), [](unsigned char c) { return isdigit(c); }))
+            filterRank = stoi(text);
+        else
+            filterRank = -2; // niepoprawna ranga - zaden wiersz nie spelnia filtru
+    }
+    else
+    {
+        transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return tolower(c); });
+        filterName = text;
+    }
+
+    beginResetModel();
+    rebuild();
+    endResetModel();
+}
+
+uint32_t RankTableModel::item(int row) const
+{
+    if(mapped)
+        return rows[row];
+
+    return sortOrder == Qt::AscendingOrder ? row : count - 1 - row;
+}
+
+bool RankTableModel::accepts(uint32_t i) const
+{
+    if(filterRank != -1)
+        return rank(i) == filterRank;
+
+    string_view n = name(i);
+
+    return search(n.begin(), n.end(), filterName.begin(), filterName.end(),
+                  [](char a, char b) { return tolower((unsigned char)a) == b; }) != n.end();
+}
+
+void RankTableModel::rebuild()
+{
+    bool filtered = filterRank != -1 || !filterName.empty();
+
+    rows.clear();
+    mapped = filtered || sortColumn != 0;
+
+    if(!mapped) // lista jest juz w porzadku alfabetycznym - wiersze wyznaczane sa bez tablicy indeksow
+    {
+        rows.shrink_to_fit();
+        return;
+    }
+
+    for(uint32_t i = 0; i < count; ++i)
+        if(!filtered || accepts(i))
+            rows.push_back(i);
+
+    if(sortColumn == 1) // sortowanie przez zliczanie - kolejnosc alfabetyczna w obrebie rangi zostaje
+        RankList::sortByRank(rows, sortOrder == Qt::AscendingOrder, [this](uint32_t i) { return rank(i); });
+    else if(sortOrder == Qt::DescendingOrder)
+        reverse(rows.begin(), rows.end());
+}
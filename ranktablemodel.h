@@ -0,0 +1,118 @@
+/**
+ * \file   ranktablemodel.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Model tabeli wynikow - leniwy odczyt listy rang z sortowaniem i filtrowaniem
+ */
+
+#ifndef RANKTABLEMODEL_H
+#define RANKTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include "authorsgraph.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+/**
+ * \brief Model tabeli par nazwisko-ranga.
+ *
+ * Model nie kopiuje wynikow - odczytuje nazwiska i rangi wprost z listy przekazanej w setRanks, wiec widok tworzy
+ * napisy tylko dla widocznych wierszy. Sortowanie i filtrowanie przestawia jedynie tablice indeksow wierszy
+ * (4 bajty na wiersz); dla porzadku alfabetycznego bez filtru tablica ta nie jest w ogole tworzona.
+ * Lista rang musi istniec do kolejnego wywolania setRanks lub clear.
+ */
+class RankTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * \brief Konstruktor pustego modelu
+     * \param parent Obiekt nadrzedny
+     */
+    explicit RankTableModel(QObject* parent = nullptr);
+
+    /**
+     * \brief Ustawia wyswietlana liste rang, zachowujac biezace sortowanie i filtr
+     * \param ranks Lista rang (nazwiska odczytywane sa z tablicy napisow grafu)
+     */
+    void setRanks(const AuthorsGraph::RankList* ranks);
+
+    /**
+     * \brief Ustawia wyswietlana liste rang, zachowujac biezace sortowanie i filtr
+     * \param ranks Lista par nazwisko-ranga w kolejnosci alfabetycznej
+     */
+    void setRanks(const std::vector<std::pair<std::string, int>>* ranks);
+
+    /**
+     * \brief Usuwa liste rang z modelu
+     */
+    void clear();
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * \brief Sortuje wiersze po nazwisku (kolumna 0) lub randze (kolumna 1, autorzy o tej samej randze alfabetycznie)
+     * \param column Kolumna
+     * \param order Kierunek sortowania
+     */
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+public slots:
+    /**
+     * \brief Ustawia filtr wierszy
+     * \param filter Fragment nazwiska (bez rozrozniania wielkosci liter), "=n" - autorzy o randze n,
+     * "=inf" - autorzy nieosiagalni. Pusty napis wylacza filtr
+     */
+    void setFilter(const QString& filter);
+
+private:
+    const AuthorsGraph::RankList* views; /**< Wyswietlana lista rang grafu (lub nullptr) */
+    const std::vector<std::pair<std::string, int>>* strings; /**< Wyswietlana lista rang z wlasnymi nazwiskami (lub nullptr) */
+    size_t count; /**< Liczba pozycji listy */
+
+    std::vector<uint32_t> rows; /**< Indeksy pozycji listy w kolejnosci wyswietlania */
+    bool mapped; /**< Czy wiersze wyznacza tablica rows (w przeciwnym razie porzadek alfabetyczny bez filtru) */
+    int sortColumn; /**< Kolumna sortowania */
+    Qt::SortOrder sortOrder; /**< Kierunek sortowania */
+    std::string filterName; /**< Filtr: fragment nazwiska (malymi literami) */
+    int filterRank; /**< Filtr: ranga (-1 - brak filtru rangi) */
+
+    /**
+     * \brief Zwraca nazwisko pozycji listy
+     */
+    std::string_view name(uint32_t i) const
+    {
+        return views ? views->getName(i) : std::string_view((*strings)[i].first);
+    }
+
+    /**
+     * \brief Zwraca range pozycji listy
+     */
+    int rank(uint32_t i) const
+    {
+        return views ? views->getRank(i) : (*strings)[i].second;
+    }
+
+    /**
+     * \brief Zwraca pozycje listy wyswietlana w wierszu
+     */
+    uint32_t item(int row) const;
+
+    /**
+     * \brief Sprawdza, czy pozycja listy spelnia filtr
+     */
+    bool accepts(uint32_t i) const;
+
+    /**
+     * \brief Wyznacza tablice wierszy dla biezacej listy, filtru i sortowania
+     */
+    void rebuild();
+};
+
+#endif // RANKTABLEMODEL_H
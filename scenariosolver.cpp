@@ -0,0 +1,137 @@
+/**
+ * \file   scenariosolver.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Rownolegle rozwiazywanie niezaleznych scenariuszy na puli watkow
+ */
+
+#include "scenariosolver.h"
+
+using namespace std;
+
+
+ScenarioSolver::ScenarioSolver(int threadCount, bool publicationsOnly, bool bipartite, Solve solve, JobProgress *progress) :
+    publicationsOnly(publicationsOnly), bipartite(bipartite), solve(solve), progress(progress), submitted(0), delivered(0), finished(false)
+{
+    if(threadCount < 1)
+        threadCount = 1;
+
+    maxPending = 2 * threadCount;
+
+    for(int t = 0; t < threadCount; ++t)
+        workers.emplace_back(&ScenarioSolver::work, this);
+}
+
+ScenarioSolver::~ScenarioSolver()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        tasks.clear();
+        finished = true;
+    }
+
+    taskReady.notify_all();
+
+    for(auto& t: workers)
+        t.join();
+}
+
+void ScenarioSolver::submit(ScenarioData &&scenario)
+{
+    {
+        unique_lock<std::mutex> lock(mutex);
+        taskTaken.wait(lock, [this]{ return tasks.size() < maxPending; });
+        tasks.emplace_back(submitted++, move(scenario));
+    }
+
+    taskReady.notify_one();
+}
+
+void ScenarioSolver::finish()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+
+    taskReady.notify_all();
+    resultReady.notify_all();
+}
+
+bool ScenarioSolver::next(ScenarioResult &result)
+{
+    unique_lock<std::mutex> lock(mutex);
+
+    resultReady.wait(lock, [this]{ return results.count(delivered) || (finished && delivered == submitted); });
+
+    auto found = results.find(delivered);
+    if(found == results.end()) // wydano wszystkie wyniki
+        return false;
+
+    result = move(found->second);
+    results.erase(found);
+    ++delivered;
+    return true;
+}
+
+bool ScenarioSolver::tryNext(ScenarioResult &result)
+{
+    lock_guard<std::mutex> lock(mutex);
+
+    auto found = results.find(delivered);
+    if(found == results.end())
+        return false;
+
+    result = move(found->second);
+    results.erase(found);
+    ++delivered;
+    return true;
+}
+
+void ScenarioSolver::work()
+{
+    unique_ptr<AuthorsGraph> graph; // graf biezacego scenariusza - przekazywany wraz z wynikiem
+    ScenarioData scenario;
+    ScenarioResult result;
+
+    for(;;)
+    {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            taskReady.wait(lock, [this]{ return !tasks.empty() || finished; });
+
+            if(tasks.empty()) // zakonczono zlecanie i oprozniono kolejke
+                return;
+
+            result.index = tasks.front().first;
+            scenario = move(tasks.front().second);
+            tasks.pop_front();
+        }
+
+        taskTaken.notify_one();
+
+        if(!graph)
+        {
+            graph.reset(new AuthorsGraph);
+            graph->setBipartite(bipartite);
+            graph->setProgress(progress);
+        }
+
+        if(publicationsOnly)
+            graph->loadGraph(scenario.publications);
+        else
+            graph->loadGraph(scenario.authors, scenario.publications);
+
+        //Lista rang wskazuje na tablice napisow grafu, wiec graf przechodzi do wyniku zamiast kopiowania nazwisk
+        result.ranks.reset(solve(*graph));
+        if(result.ranks) // nullptr - przerwane zadanie, graf moze byc uzyty ponownie
+            result.graph = move(graph);
+
+        {
+            lock_guard<std::mutex> lock(mutex);
+            results.emplace(result.index, move(result));
+        }
+
+        resultReady.notify_all();
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * \file   scenariosolver.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Rownolegle rozwiazywanie niezaleznych scenariuszy na puli watkow
+ */
+
+#ifndef SCENARIOSOLVER_H
+#define SCENARIOSOLVER_H
+
+#include "authorsgraph.h"
+#include "xmlscenarioreader.h"
+#include <vector>
+#include <string>
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * \brief Wynik pojedynczego scenariusza.
+ *
+ * Lista rang odczytuje nazwiska wprost z tablicy napisow grafu scenariusza, wiec wynik przejmuje graf na wlasnosc
+ * - nazwiska nie sa kopiowane.
+ */
+struct ScenarioResult
+{
+    int index; /**< Numer scenariusza w kolejnosci zlecenia (od 0) */
+    std::unique_ptr<AuthorsGraph> graph; /**< Graf scenariusza, do ktorego odwoluje sie lista rang */
+    std::unique_ptr<AuthorsGraph::RankList> ranks; /**< Rangi w kolejnosci alfabetycznej (nullptr - przerwane zadanie) */
+};
+
+/**
+ * \brief Pula watkow budujaca i rozwiazujaca scenariusze.
+ *
+ * Kazdy watek pobiera scenariusz z kolejki, laduje go do wlasnego grafu, oblicza rangi i odklada wynik razem z grafem
+ * (kolejny scenariusz trafia do nowego grafu, a graf przerwanego scenariusza jest uzywany ponownie). Wyniki wydawane
+ * sa w kolejnosci zlecenia, niezaleznie od kolejnosci zakonczenia. Kolejka zlecen jest ograniczona (dwa scenariusze na watek), wiec czytanie pliku
+ * nie wyprzedza obliczen o wiecej niz kilka scenariuszy.
+ */
+class ScenarioSolver
+{
+public:
+    typedef std::function<AuthorsGraph::RankList *(AuthorsGraph&)> Solve; /**< Algorytm wywolywany na zaladowanym grafie */
+
+    /**
+     * \brief Konstruktor uruchamiajacy watki puli
+     * \param threadCount Liczba watkow (wartosci mniejsze od 1 traktowane sa jak 1)
+     * \param publicationsOnly Czy wezly tworzyc na podstawie publikacji (w przeciwnym wypadku na podstawie listy autorow)
+     * \param bipartite Czy grafy watkow przechowuja publikacje jako hiperkrawedzie (patrz AuthorsGraph::setBipartite)
+     * \param solve Algorytm wyznaczajacy rangi. Wywolywany wspolbieznie, wiec nie moze korzystac z GUI
+     * \param progress Postep zadania, do ktorego przypinane sa grafy watkow (lub nullptr). Po przerwaniu zadania
+     * scenariusze w trakcie obliczen otrzymuja puste wyniki
+     */
+    ScenarioSolver(int threadCount, bool publicationsOnly, bool bipartite, Solve solve, JobProgress* progress = nullptr);
+
+    /**
+     * \brief Destruktor. Porzuca niepobrane zlecenia i czeka na zakonczenie watkow
+     */
+    ~ScenarioSolver();
+
+    ScenarioSolver(const ScenarioSolver&) = delete;
+    ScenarioSolver& operator=(const ScenarioSolver&) = delete;
+
+    /**
+     * \brief Zleca rozwiazanie scenariusza. Czeka, jesli kolejka zlecen jest pelna
+     * \param scenario Dane scenariusza (przenoszone)
+     */
+    void submit(ScenarioData&& scenario);
+
+    /**
+     * \brief Informuje pule, ze nie bedzie kolejnych zlecen
+     */
+    void finish();
+
+    /**
+     * \brief Pobiera kolejny (w kolejnosci zlecenia) wynik, czekajac na jego obliczenie
+     * \param result Zmienna, do ktorej zostanie przeniesiony wynik
+     * \return Zwraca false, jesli po wywolaniu finish() wydano juz wszystkie wyniki
+     */
+    bool next(ScenarioResult& result);
+
+    /**
+     * \brief Pobiera kolejny (w kolejnosci zlecenia) wynik, o ile jest juz gotowy
+     * \param result Zmienna, do ktorej zostanie przeniesiony wynik
+     * \return Zwraca true, jesli wynik byl gotowy
+     */
+    bool tryNext(ScenarioResult& result);
+
+private:
+    bool publicationsOnly; /**< Sposob ladowania grafow */
+    bool bipartite; /**< Sposob przechowywania grafow */
+    Solve solve; /**< Algorytm wyznaczajacy rangi */
+    JobProgress* progress; /**< Postep zadania (lub nullptr) */
+    size_t maxPending; /**< Najwieksza liczba oczekujacych zlecen */
+
+    std::vector<std::thread> workers; /**< Watki puli */
+    std::mutex mutex; /**< Chroni kolejke, wyniki i liczniki */
+    std::condition_variable taskReady; /**< Pojawilo sie zlecenie lub zakonczono zlecanie */
+    std::condition_variable taskTaken; /**< Zwolnilo sie miejsce w kolejce zlecen */
+    std::condition_variable resultReady; /**< Pojawil sie wynik */
+    std::deque<std::pair<int, ScenarioData>> tasks; /**< Zlecenia oczekujace na watek */
+    std::map<int, ScenarioResult> results; /**< Obliczone wyniki oczekujace na wydanie */
+    int submitted; /**< Liczba zlecen */
+    int delivered; /**< Liczba wydanych wynikow */
+    bool finished; /**< Czy zakonczono zlecanie */
+
+    /**
+     * \brief Petla watku puli
+     */
+    void work();
+};
+
+#endif // SCENARIOSOLVER_H
@@ -0,0 +1,96 @@
+/**
+ * \file   stringarena.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Arena internujaca nazwiska autorow
+ */
+
+#include "stringarena.h"
+#include <functional>
+#include <algorithm>
+
+
+StringArena::StringArena()
+{
+    clear();
+}
+
+size_t StringArena::probe(std::string_view s) const
+{
+    size_t mask = index.size() - 1;
+    size_t slot = std::hash<std::string_view>()(s) & mask;
+
+    while(index[slot] != 0 && get(index[slot] - 1) != s) // sondowanie liniowe
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+void StringArena::grow()
+{
+    std::vector<uint32_t> old(index.size() * 2, 0);
+    index.swap(old);
+
+    for(uint32_t entry: old)
+        if(entry != 0)
+            index[probe(get(entry - 1))] = entry;
+}
+
+StringArena::Id StringArena::intern(std::string_view s)
+{
+    size_t slot = probe(s);
+
+    if(index[slot] != 0)
+        return index[slot] - 1;
+
+    Id id = size();
+    chars.insert(chars.end(), s.begin(), s.end());
+    offsets.push_back(chars.size());
+    index[slot] = id + 1;
+
+    if(2 * size() > index.size()) // wspolczynnik zapelnienia nie wiekszy niz 1/2
+        grow();
+
+    return id;
+}
+
+bool StringArena::find(std::string_view s, Id &id) const
+{
+    size_t slot = probe(s);
+
+    if(index[slot] == 0)
+        return false;
+
+    id = index[slot] - 1;
+    return true;
+}
+
+void StringArena::permute(const std::vector<Id> &order)
+{
+    std::vector<char> permutedChars;
+    std::vector<uint32_t> permutedOffsets(1, 0);
+
+    permutedChars.reserve(chars.size());
+    permutedOffsets.reserve(offsets.size());
+
+    for(Id id: order)
+    {
+        std::string_view s = get(id);
+        permutedChars.insert(permutedChars.end(), s.begin(), s.end());
+        permutedOffsets.push_back(permutedChars.size());
+    }
+
+    chars.swap(permutedChars);
+    offsets.swap(permutedOffsets);
+
+    std::fill(index.begin(), index.end(), 0); // rozmiar indeksu sie nie zmienia - wpisy ukladane od nowa
+    for(Id id = 0; id < size(); ++id)
+        index[probe(get(id))] = id + 1;
+}
+
+void StringArena::clear()
+{
+    chars.clear();
+    offsets.assign(1, 0);
+    index.assign(16, 0);
+}
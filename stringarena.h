@@ -0,0 +1,111 @@
+/**
+ * \file   stringarena.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Arena internujaca nazwiska autorow
+ */
+
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \brief Arena internujaca napisy.
+ *
+ * Kazdy rozny napis przechowywany jest raz, w jednym ciaglym buforze znakow, i otrzymuje kolejny identyfikator
+ * (0, 1, 2, ...). Indeks mieszajacy (adresowanie otwarte) przechowuje wylacznie identyfikatory, wiec internowanie
+ * nie tworzy obiektow std::string. Identyfikatory sa stale; widoki zwracane przez get() pozostaja wazne do
+ * kolejnego wywolania intern() lub clear().
+ */
+class StringArena
+{
+public:
+    typedef uint32_t Id; /**< Identyfikator napisu */
+
+    /** Konstruktor pustej areny */
+    StringArena();
+
+    /**
+     * \brief Zwraca identyfikator napisu, dodajac go do areny, jesli jeszcze w niej nie wystepuje
+     * \param s Napis
+     * \return Zwraca identyfikator napisu
+     */
+    Id intern(std::string_view s);
+
+    /**
+     * \brief Wyszukuje napis
+     * \param s Napis
+     * \param id Zmienna, do ktorej zostanie zapisany identyfikator
+     * \return Zwraca true, jesli napis wystepuje w arenie
+     */
+    bool find(std::string_view s, Id& id) const;
+
+    /**
+     * \brief Zwraca napis o danym identyfikatorze
+     * \param id Identyfikator napisu
+     * \return Zwraca widok na napis w buforze areny
+     */
+    std::string_view get(Id id) const
+    {
+        return std::string_view(chars.data() + offsets[id], offsets[id+1] - offsets[id]);
+    }
+
+    /**
+     * \brief Zwraca liczbe napisow
+     * \return Zwraca liczbe roznych napisow w arenie
+     */
+    size_t size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    /**
+     * \brief Zwraca bufor znakow wszystkich napisow
+     * \return Zwraca wskaznik na pierwszy znak
+     */
+    const char* charsData() const
+    {
+        return chars.data();
+    }
+
+    /**
+     * \brief Zwraca tablice poczatkow napisow (size()+1 elementow)
+     * \return Zwraca wskaznik na tablice poczatkow
+     */
+    const uint32_t* offsetsData() const
+    {
+        return offsets.data();
+    }
+
+    /**
+     * \brief Przenumerowuje napisy - napis order[i] otrzymuje identyfikator i. Uniewaznia wszystkie widoki
+     * \param order Permutacja identyfikatorow (size() elementow): nowy identyfikator -> dotychczasowy
+     */
+    void permute(const std::vector<Id>& order);
+
+    /**
+     * \brief Usuwa wszystkie napisy
+     */
+    void clear();
+
+private:
+    std::vector<char> chars; /**< Skonkatenowane napisy */
+    std::vector<uint32_t> offsets; /**< Napis i to chars[offsets[i]..offsets[i+1]) */
+    std::vector<uint32_t> index; /**< Indeks mieszajacy: identyfikator+1 lub 0 dla pustego miejsca */
+
+    /**
+     * \brief Zwraca miejsce w indeksie zajete przez napis lub pierwsze wolne miejsce na jego sciezce
+     */
+    size_t probe(std::string_view s) const;
+
+    /**
+     * \brief Podwaja indeks mieszajacy
+     */
+    void grow();
+};
+
+#endif // STRINGARENA_H
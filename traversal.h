@@ -0,0 +1,222 @@
+/**
+ * \file   traversal.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Pamiec robocza przeszukiwan grafu ze znacznikami odwiedzin opatrzonymi numerem przebiegu
+ */
+
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <tuple>
+#include <cstdint>
+#include "bitmap.h"
+#include "priorityqueues.h"
+#include "parallel.h"
+
+/**
+ * \brief Pamiec robocza jednego przeszukiwania (np. jednej strony dwukierunkowego BFS).
+ *
+ * Autor jest odwiedzony w biezacym przebiegu, jesli jego znacznik rowna sie numerowi przebiegu. Rozpoczecie
+ * przebiegu (start) zwieksza jedynie numer, wiec tablice nie sa zerowane pomiedzy zapytaniami - odleglosc, rodzic
+ * i publikacja autora sa wazne tylko dla odwiedzonych. Tablice sa czyszczone dopiero po przepelnieniu numeru.
+ */
+class TraversalSide
+{
+public:
+    std::vector<uint32_t> distance; /**< Odleglosc od zrodla (wazna dla odwiedzonych) */
+    std::vector<uint32_t> parent; /**< Autor, z ktorego osiagnieto autora (wazny dla odwiedzonych) */
+    std::vector<uint32_t> publication; /**< Publikacja laczaca autora z rodzicem (wazna dla odwiedzonych) */
+    std::vector<uint32_t> frontier; /**< Biezaca warstwa przeszukiwania */
+    size_t visitedCount = 0; /**< Liczba autorow odwiedzonych w biezacym przebiegu */
+
+    /**
+     * \brief Rozpoczyna przebieg - wszyscy autorzy i publikacje staja sie nieodwiedzeni. Tablice rosna do rozmiaru grafu
+     * \param authors Liczba autorow grafu
+     * \param papers Liczba publikacji grafu (tryb dwudzielny, w przeciwnym razie 0)
+     */
+    void start(size_t authors, size_t papers)
+    {
+        if(stamp.size() < authors)
+        {
+            stamp.resize(authors, 0);
+            distance.resize(authors);
+            parent.resize(authors);
+            publication.resize(authors);
+        }
+
+        if(paperStamp.size() < papers)
+            paperStamp.resize(papers, 0);
+
+        if(++epoch == 0) // przepelnienie numeru - jedyne zerowanie tablic
+        {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            std::fill(paperStamp.begin(), paperStamp.end(), 0);
+            epoch = 1;
+        }
+
+        frontier.clear();
+        visitedCount = 0;
+    }
+
+    /**
+     * \brief Informuje czy autor zostal odwiedzony w biezacym przebiegu
+     */
+    bool isVisited(uint32_t author) const
+    {
+        return stamp[author] == epoch;
+    }
+
+    /**
+     * \brief Oznacza autora jako odwiedzonego
+     * \return Zwraca false, jesli autor byl juz odwiedzony (dane autora nie sa wtedy zmieniane)
+     */
+    bool visit(uint32_t author, uint32_t from, uint32_t paper, uint32_t dist)
+    {
+        if(stamp[author] == epoch)
+            return false;
+
+        stamp[author] = epoch;
+        distance[author] = dist;
+        parent[author] = from;
+        publication[author] = paper;
+        ++visitedCount;
+        return true;
+    }
+
+    /**
+     * \brief Oznacza publikacje jako rozwinieta
+     * \return Zwraca false, jesli publikacja byla juz rozwinieta w biezacym przebiegu
+     */
+    bool expand(uint32_t paper)
+    {
+        if(paperStamp[paper] == epoch)
+            return false;
+
+        paperStamp[paper] = epoch;
+        return true;
+    }
+
+private:
+    std::vector<uint32_t> stamp; /**< Numer przebiegu, w ktorym odwiedzono autora */
+    std::vector<uint32_t> paperStamp; /**< Numer przebiegu, w ktorym rozwinieto publikacje */
+    uint32_t epoch = 0; /**< Numer biezacego przebiegu */
+};
+
+/**
+ * \brief Pamiec jednego watku BFS wielowatkowego. Wyrownana do linii pamieci podrecznej, wiec zakresy paczek
+ * roznych watkow nie dziela linii
+ */
+struct alignas(64) TraversalThread
+{
+    std::atomic<uint64_t> chunks{0}; /**< Zakres paczek frontu (pierwsza << 32 | koniec) - wlasciciel pobiera paczki
+                                          od poczatku, pozostale watki kradna je od konca */
+    std::vector<uint32_t> next; /**< Lokalny front nastepnej warstwy */
+    std::vector<uint32_t> decoded; /**< Odczytana lista wspolpracownikow (graf ze skompresowanymi listami) */
+    size_t offset = 0; /**< Miejsce lokalnego frontu w scalonym froncie */
+};
+
+/**
+ * \brief Pamiec robocza zapytania: obie strony dwukierunkowego przeszukiwania, kolejki i mapy bitowe wyznaczania
+ * rang, zespol watkow BFS wielowatkowego oraz bufor odczytu list. Kolejki i mapy sa czyszczone przed uzyciem,
+ * ale zachowuja przydzielona pamiec
+ */
+struct TraversalWorkspace
+{
+    TraversalSide sides[2]; /**< Strona 0 - od autora poczatkowego, strona 1 - od koncowego */
+    std::vector<uint32_t> next; /**< Nastepna warstwa rozwijanej strony, kolejka FIFO BFS lub front BFS wielowatkowego */
+    std::vector<uint32_t> decoded; /**< Odczytana lista wspolpracownikow (graf ze skompresowanymi listami) */
+    Bitmap layers[3]; /**< BFS hybrydowy: odwiedzeni, biezaca i nastepna warstwa */
+    std::tuple<BucketQueue, RadixHeap, DAryHeap<4>, PairingHeap> queues; /**< Kolejki algorytmu Dijkstry (std::get<Queue>) */
+    ThreadTeam team; /**< BFS wielowatkowy: watki pomocnicze, zachowywane pomiedzy zapytaniami */
+    std::vector<std::unique_ptr<TraversalThread>> threads; /**< BFS wielowatkowy: pamieci watkow */
+    std::unique_ptr<std::atomic<int32_t>[]> levels; /**< BFS wielowatkowy: rangi autorow - pomiedzy zapytaniami
+                                                         wszystkie nieskonczone, wiec tablica nie jest inicjalizowana */
+    size_t levelsSize = 0; /**< Liczba elementow tablicy levels */
+};
+
+/**
+ * \brief Pula pamieci roboczych dla jednoczesnych zapytan.
+ *
+ * Kazde zapytanie pobiera pamiec na czas swojego trwania i oddaje ja do puli, wiec liczba pamieci rowna sie
+ * najwiekszej liczbie jednoczesnych zapytan, a kolejne zapytania na tym samym grafie nie alokuja pamieci.
+ */
+class TraversalPool
+{
+public:
+    /**
+     * \brief Pamiec pobrana z puli - oddawana automatycznie przy zniszczeniu
+     */
+    class Lease
+    {
+    public:
+        Lease(TraversalPool& pool, std::unique_ptr<TraversalWorkspace> workspace) : pool(pool), workspace(std::move(workspace))
+        {}
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease()
+        {
+            pool.release(std::move(workspace));
+        }
+
+        TraversalWorkspace& operator*() const
+        {
+            return *workspace;
+        }
+
+        TraversalWorkspace* operator->() const
+        {
+            return workspace.get();
+        }
+
+    private:
+        TraversalPool& pool; /**< Pula, do ktorej pamiec zostanie oddana */
+        std::unique_ptr<TraversalWorkspace> workspace; /**< Pobrana pamiec */
+    };
+
+    /**
+     * \brief Pobiera wolna pamiec z puli lub tworzy nowa, jesli wszystkie sa w uzyciu
+     */
+    Lease acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(idle.empty())
+            return Lease(*this, std::unique_ptr<TraversalWorkspace>(new TraversalWorkspace()));
+
+        std::unique_ptr<TraversalWorkspace> workspace = std::move(idle.back());
+        idle.pop_back();
+        return Lease(*this, std::move(workspace));
+    }
+
+    /**
+     * \brief Zwalnia wszystkie nieuzywane pamieci (np. po wyczyszczeniu grafu)
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle.clear();
+    }
+
+private:
+    std::mutex mutex; /**< Ochrona listy wolnych pamieci */
+    std::vector<std::unique_ptr<TraversalWorkspace>> idle; /**< Wolne pamieci */
+
+    /**
+     * \brief Oddaje pamiec do puli
+     */
+    void release(std::unique_ptr<TraversalWorkspace> workspace)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle.push_back(std::move(workspace));
+    }
+};
+
+#endif // TRAVERSAL_H
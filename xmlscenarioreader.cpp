@@ -0,0 +1,228 @@
+/**
+ * \file   xmlscenarioreader.cpp
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Strumieniowy czytnik scenariuszy z pliku XML
+ */
+
+#include "xmlscenarioreader.h"
+#include "authorsgraph.h"
+
+
+namespace
+{
+/**
+ * \brief Odbiorca budujacy graf bezposrednio podczas czytania
+ */
+class GraphSink
+{
+    AuthorsGraph& graph; /**< Budowany graf */
+    bool publicationsOnly; /**< Czy wezly tworzone sa na podstawie publikacji */
+    vector<AuthorsGraph::AuthorId>& publication; /**< Identyfikatory autorow biezacej publikacji */
+
+public:
+    GraphSink(AuthorsGraph& graph, bool publicationsOnly, vector<AuthorsGraph::AuthorId>& publication) :
+        graph(graph), publicationsOnly(publicationsOnly), publication(publication)
+    {}
+
+    void author(string_view name)
+    {
+        if(!publicationsOnly)
+            graph.addAuthor(name);
+    }
+
+    void beginPublication()
+    {
+        publication.clear();
+    }
+
+    void coAuthor(string_view name)
+    {
+        AuthorsGraph::AuthorId id;
+
+        //Przy pelnym ladowaniu autorzy nieobecni na liscie sa pomijani
+        if(publicationsOnly)
+            publication.push_back(graph.addAuthor(name));
+        else if(graph.findAuthor(name, id))
+            publication.push_back(id);
+    }
+
+    void endPublication()
+    {
+        graph.addPublication(publication);
+    }
+};
+
+/**
+ * \brief Odbiorca zapisujacy scenariusz jako listy nazwisk
+ */
+class DataSink
+{
+    ScenarioData& scenario; /**< Wczytywany scenariusz */
+
+public:
+    explicit DataSink(ScenarioData& scenario) : scenario(scenario)
+    {}
+
+    void author(string_view name)
+    {
+        scenario.authors.emplace_back(name);
+    }
+
+    void beginPublication()
+    {
+        scenario.publications.emplace_back();
+    }
+
+    void coAuthor(string_view name)
+    {
+        scenario.publications.back().emplace_back(name);
+    }
+
+    void endPublication()
+    {}
+};
+}
+
+
+XmlScenarioReader::XmlScenarioReader(QIODevice *device) : xml(device)
+{}
+
+QString XmlScenarioReader::errorString() const
+{
+    return xml.errorString() + " (linia " + QString::number(xml.lineNumber()) + ")";
+}
+
+bool XmlScenarioReader::readScenario(AuthorsGraph &graph, bool publicationsOnly)
+{
+    GraphSink sink(graph, publicationsOnly, publication);
+
+    graph.clear();
+
+    if(!readNextScenario(sink))
+        return false;
+
+    graph.freeze();
+    return true;
+}
+
+bool XmlScenarioReader::readScenario(ScenarioData &scenario)
+{
+    DataSink sink(scenario);
+
+    scenario.authors.clear();
+    scenario.publications.clear();
+
+    return readNextScenario(sink);
+}
+
+template<class Sink>
+bool XmlScenarioReader::readNextScenario(Sink &sink)
+{
+    while(!xml.atEnd()) // przejdz do kolejnego elementu Scenario, na dowolnej glebokosci
+    {
+        if(xml.readNext() == QXmlStreamReader::StartElement && xml.name() == QLatin1String("Scenario"))
+        {
+            if(!readScenarioElement(sink))
+            {
+                if(!xml.hasError())
+                    xml.raiseError("Niepoprawna struktura scenariusza");
+                return false;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template<class Sink>
+bool XmlScenarioReader::readScenarioElement(Sink &sink)
+{
+    int authorsCount = 0;
+    int publicationsCount = 0;
+
+    while(xml.readNextStartElement())
+    {
+        if(xml.name() == QLatin1String("Authors"))
+        {
+            //W pelnym ladowaniu wezly tworzone sa z listy autorow, wiec musi ona poprzedzac publikacje
+            if(++authorsCount > 1 || publicationsCount > 0 || !readAuthors(sink))
+                return false;
+        }
+        else if(xml.name() == QLatin1String("Publications"))
+        {
+            if(++publicationsCount > 1 || authorsCount == 0 || !readPublications(sink))
+                return false;
+        }
+        else
+            xml.skipCurrentElement();
+    }
+
+    return !xml.hasError() && authorsCount == 1 && publicationsCount == 1;
+}
+
+template<class Sink>
+bool XmlScenarioReader::readAuthors(Sink &sink)
+{
+    bool erdosSpotted = false;
+    int count = 0;
+
+    while(xml.readNextStartElement())
+    {
+        if(xml.name() == QLatin1String("Author"))
+        {
+            QByteArray utf8 = xml.attributes().value("Name").toUtf8();
+            string_view name(utf8.constData(), utf8.size());
+
+            if(name == "Erdos")
+                erdosSpotted = true;
+
+            sink.author(name);
+            ++count;
+        }
+
+        xml.skipCurrentElement();
+    }
+
+    return count > 0 && erdosSpotted;
+}
+
+template<class Sink>
+bool XmlScenarioReader::readPublications(Sink &sink)
+{
+    int count = 0;
+
+    while(xml.readNextStartElement())
+    {
+        if(xml.name() != QLatin1String("Publication"))
+        {
+            xml.skipCurrentElement();
+            continue;
+        }
+
+        sink.beginPublication();
+        int authors = 0;
+
+        while(xml.readNextStartElement()) // autorzy publikacji
+        {
+            if(xml.name() == QLatin1String("Author"))
+            {
+                QByteArray utf8 = xml.attributes().value("Name").toUtf8();
+                sink.coAuthor(string_view(utf8.constData(), utf8.size()));
+                ++authors;
+            }
+
+            xml.skipCurrentElement();
+        }
+
+        if(authors == 0)
+            return false;
+
+        sink.endPublication();
+        ++count;
+    }
+
+    return count > 0;
+}
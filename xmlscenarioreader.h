@@ -0,0 +1,121 @@
+/**
+ * \file   xmlscenarioreader.h
+ * \author Michał Kamiński
+ * \date   20-01-2015
+ * \brief  Strumieniowy czytnik scenariuszy z pliku XML
+ */
+
+#ifndef XMLSCENARIOREADER_H
+#define XMLSCENARIOREADER_H
+
+#include <QXmlStreamReader>
+#include <QString>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class AuthorsGraph;
+
+/**
+ * \brief Dane pojedynczego scenariusza, wczytane bez budowania grafu
+ */
+struct ScenarioData
+{
+    std::vector<std::string> authors; /**< Lista autorow */
+    std::vector<std::vector<std::string>> publications; /**< Lista publikacji (nazwiska wspolautorow) */
+};
+
+/**
+ * \brief Strumieniowy czytnik scenariuszy z pliku XML.
+ *
+ * Czyta plik jednym przebiegiem (QXmlStreamReader) i przekazuje nazwiska autorow bezposrednio do areny budowanego grafu,
+ * a do publikacji trafiaja juz tylko identyfikatory.
+ * W pamieci przechowywany jest jedynie graf biezacego scenariusza oraz lista autorow biezacej publikacji,
+ * niezaleznie od rozmiaru calego dokumentu. Wymaga, aby w scenariuszu sekcja Authors poprzedzala sekcje Publications.
+ */
+class XmlScenarioReader
+{
+public:
+    /**
+     * \brief Konstruktor czytnika
+     * \param device Otwarte zrodlo danych XML
+     */
+    explicit XmlScenarioReader(QIODevice* device);
+
+    /**
+     * \brief Wczytuje kolejny scenariusz do grafu i zamraza graf
+     * \param graph Graf, ktory zostanie wyczyszczony i zaladowany danymi scenariusza
+     * \param publicationsOnly Czy wezly tworzyc na podstawie publikacji (w przeciwnym wypadku na podstawie listy autorow)
+     * \return Zwraca true, jesli wczytano scenariusz. Zwraca false na koncu pliku lub w przypadku bledu (patrz hasError)
+     */
+    bool readScenario(AuthorsGraph& graph, bool publicationsOnly);
+
+    /**
+     * \brief Wczytuje kolejny scenariusz jako listy autorow i publikacji, bez budowania grafu.
+     * Pozwala zbudowac graf scenariusza w innym watku (patrz ScenarioSolver)
+     * \param scenario Dane, ktore zostana zastapione danymi scenariusza
+     * \return Zwraca true, jesli wczytano scenariusz. Zwraca false na koncu pliku lub w przypadku bledu (patrz hasError)
+     */
+    bool readScenario(ScenarioData& scenario);
+
+    /**
+     * \brief Informuje czy wystapil blad skladni lub struktury pliku
+     * \return Zwraca true, jesli wystapil blad
+     */
+    bool hasError() const
+    {
+        return xml.hasError();
+    }
+
+    /**
+     * \brief Zwraca opis bledu
+     * \return Zwraca opis bledu wraz z numerem linii
+     */
+    QString errorString() const;
+
+private:
+    QXmlStreamReader xml; /**< Strumieniowy parser XML */
+    std::vector<uint32_t> publication; /**< Identyfikatory autorow biezacej publikacji */
+
+    /*
+     * Odbiorca (Sink) przyjmuje wczytane elementy scenariusza:
+     *   void author(string_view name) - autor z listy Authors
+     *   void beginPublication() - poczatek publikacji
+     *   void coAuthor(string_view name) - autor biezacej publikacji
+     *   void endPublication() - koniec publikacji
+     */
+
+    /**
+     * \brief Przechodzi do kolejnego elementu Scenario i wczytuje go
+     * \param sink Odbiorca elementow scenariusza
+     * \return Zwraca true, jesli wczytano poprawny scenariusz
+     */
+    template<class Sink>
+    bool readNextScenario(Sink& sink);
+
+    /**
+     * \brief Wczytuje zawartosc elementu Scenario
+     * \param sink Odbiorca elementow scenariusza
+     * \return Zwraca true, jesli scenariusz jest poprawny
+     */
+    template<class Sink>
+    bool readScenarioElement(Sink& sink);
+
+    /**
+     * \brief Wczytuje zawartosc elementu Authors
+     * \param sink Odbiorca elementow scenariusza
+     * \return Zwraca true, jesli lista jest niepusta i zawiera Erdosa
+     */
+    template<class Sink>
+    bool readAuthors(Sink& sink);
+
+    /**
+     * \brief Wczytuje zawartosc elementu Publications
+     * \param sink Odbiorca elementow scenariusza
+     * \return Zwraca true, jesli lista publikacji jest niepusta, a kazda publikacja ma autorow
+     */
+    template<class Sink>
+    bool readPublications(Sink& sink);
+};
+
+#endif // XMLSCENARIOREADER_H